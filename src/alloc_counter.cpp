@@ -0,0 +1,79 @@
+#include "alloc_counter.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace robikzinputtest::alloc_counter {
+
+static std::atomic<uint64_t> s_allocations { 0 };
+
+static void *counted_malloc(size_t size) {
+	s_allocations.fetch_add(1, std::memory_order_relaxed);
+	// malloc(0) may return nullptr, which new must not.
+	return std::malloc(size > 0 ? size : 1);
+}
+
+uint64_t count() {
+	return s_allocations.load(std::memory_order_relaxed);
+}
+
+void *allocate(size_t size, void *user_data) {
+	(void) user_data;
+	return counted_malloc(size);
+}
+
+void release(void *ptr, void *user_data) {
+	(void) user_data;
+	std::free(ptr);
+}
+
+} // namespace robikzinputtest::alloc_counter
+
+/*
+  Replaced global allocation functions; the aligned ones keep their
+  default pairs.
+*/
+
+void *operator new(size_t size) {
+	if (void *ptr = robikzinputtest::alloc_counter::allocate(size, nullptr)) {
+		return ptr;
+	}
+	throw std::bad_alloc();
+}
+
+void *operator new[](size_t size) {
+	return operator new(size);
+}
+
+void *operator new(size_t size, const std::nothrow_t &) noexcept {
+	return robikzinputtest::alloc_counter::allocate(size, nullptr);
+}
+
+void *operator new[](size_t size, const std::nothrow_t &) noexcept {
+	return robikzinputtest::alloc_counter::allocate(size, nullptr);
+}
+
+void operator delete(void *ptr) noexcept {
+	std::free(ptr);
+}
+
+void operator delete[](void *ptr) noexcept {
+	std::free(ptr);
+}
+
+void operator delete(void *ptr, size_t) noexcept {
+	std::free(ptr);
+}
+
+void operator delete[](void *ptr, size_t) noexcept {
+	std::free(ptr);
+}
+
+void operator delete(void *ptr, const std::nothrow_t &) noexcept {
+	std::free(ptr);
+}
+
+void operator delete[](void *ptr, const std::nothrow_t &) noexcept {
+	std::free(ptr);
+}
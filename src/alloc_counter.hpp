@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Count of the heap allocations, to tell how many each frame makes.
+ *
+ * The global operator new is replaced to count its calls; allocators
+ * that bypass it, like ImGui's, are routed through allocate() and
+ * release() instead. The count is a relaxed atomic increment, cheap
+ * enough to stay on in every build.
+ */
+namespace robikzinputtest::alloc_counter {
+
+/// Allocations made since the start of the program.
+uint64_t count();
+
+/// malloc() that is counted, for allocators that can be plugged in.
+void *allocate(size_t size, void *user_data);
+/// free() to go with allocate().
+void release(void *ptr, void *user_data);
+
+} // namespace robikzinputtest::alloc_counter
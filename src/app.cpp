@@ -1,15 +1,35 @@
 #include "app.hpp"
 #include "arena.hpp"
+#include "axis_noise.hpp"
+#include "axis_response.hpp"
 #include "clock.hpp"
+#include "command_line.hpp"
 #include "controller.hpp"
 #include "controller_system.hpp"
+#include "display_registry.hpp"
+#include "frame_capture.hpp"
+#include "frame_pacer.hpp"
+#include "event_rate_monitor.hpp"
+#include "frame_profiler.hpp"
 #include "gizmo.hpp"
 #include "gui.hpp"
+#include "input_recording.hpp"
+#include "input_timing.hpp"
+#include "joystick_snapshot.hpp"
+#include "keyboard_state.hpp"
 #include "logger.hpp"
+#include "present_timing.hpp"
+#include "render_benchmark.hpp"
+#include "self_test.hpp"
+#include "sensor_capture.hpp"
+#include "sensor_simulator.hpp"
 #include "sdl_event.hpp"
 #include "sdl_settings.hpp"
 #include "sdl_window.hpp"
 #include "settings.hpp"
+#include "settings_persistence.hpp"
+#include "settings_profiles.hpp"
+#include "startup_timer.hpp"
 #include "version.hpp"
 #include "video.hpp"
 #include "video_settings.hpp"
@@ -21,7 +41,10 @@
 
 #include <algorithm>
 #include <array>
+#include <cmath>
+#include <fstream>
 #include <functional>
+#include <future>
 #include <iostream>
 #include <map>
 #include <memory>
@@ -39,6 +62,11 @@ bool is_quit_key(const SDL_KeyboardEvent &key)
 	return (key.key == SDLK_Q && (key.mod & SDL_KMOD_CTRL));
 }
 
+bool is_next_profile_key(const SDL_KeyboardEvent &key)
+{
+	return key.key == SDLK_F6 && !key.repeat;
+}
+
 bool is_alt_enter(const SDL_KeyboardEvent &key)
 {
 	return key.key == SDLK_RETURN
@@ -56,6 +84,29 @@ bool is_joystick_gizmo_create_key(const SDL_JoyButtonEvent &jbutton)
 	return jbutton.down;
 }
 
+bool is_mouse_gizmo_create_button(const SDL_MouseButtonEvent &button)
+{
+	return button.type == SDL_EVENT_MOUSE_BUTTON_DOWN;
+}
+
+bool is_mouse_release_key(const SDL_Event &event)
+{
+	return event.type == SDL_EVENT_KEY_DOWN && event.key.key == SDLK_ESCAPE;
+}
+
+/**
+ * Mouse event that came from a mouse, not emulated from touch or pen.
+ */
+bool is_physical_mouse_event(const SDL_Event &event)
+{
+	using namespace robikzinputtest::sdl;
+	if (!is_mouse_event(event)) {
+		return false;
+	}
+	const SDL_MouseID which = get_mouse_event_which(event);
+	return which != SDL_TOUCH_MOUSEID && which != SDL_PEN_MOUSEID;
+}
+
 bool is_keyboard_priority_event(const SDL_Event &event)
 {
 	using namespace robikzinputtest::sdl;
@@ -63,13 +114,64 @@ bool is_keyboard_priority_event(const SDL_Event &event)
 		&& (
 			is_quit_key(event.key)
 			|| is_alt_enter(event.key)
+			|| is_next_profile_key(event.key)
 		);
 }
 
+bool video_settings_differ(const Settings &a, const Settings &b)
+{
+	return a.display_mode != b.display_mode
+		|| a.windowed_x != b.windowed_x
+		|| a.windowed_y != b.windowed_y
+		|| a.windowed_width != b.windowed_width
+		|| a.windowed_height != b.windowed_height
+		|| a.windowed_maximized != b.windowed_maximized
+		|| a.fullscreen_width != b.fullscreen_width
+		|| a.fullscreen_height != b.fullscreen_height
+		|| a.fullscreen_refresh_rate_numerator != b.fullscreen_refresh_rate_numerator
+		|| a.fullscreen_refresh_rate_denominator != b.fullscreen_refresh_rate_denominator
+		|| a.fullscreen_pixel_format != b.fullscreen_pixel_format
+		|| a.fullscreen_pixel_density != b.fullscreen_pixel_density
+		|| a.fullscreen_display.id != b.fullscreen_display.id
+		|| a.fullscreen_display.name != b.fullscreen_display.name;
+}
+
+bool axis_response_settings_differ(const Settings &a, const Settings &b)
+{
+	return a.joystick_deadzone != b.joystick_deadzone
+		|| a.joystick_outer_deadzone != b.joystick_outer_deadzone
+		|| a.joystick_anti_deadzone != b.joystick_anti_deadzone
+		|| a.joystick_response_exponent != b.joystick_response_exponent
+		|| a.joystick_radial_deadzone != b.joystick_radial_deadzone;
+}
+
+/**
+ * The refresh rate of the window's display as a fraction; 0/0 if
+ * there's no window yet or the rate is unknown.
+ */
+std::pair<int, int> window_refresh_rate(SDL_Window *window)
+{
+	const SDL_DisplayMode *mode = window != nullptr
+		? SDL_GetCurrentDisplayMode(SDL_GetDisplayForWindow(window))
+		: nullptr;
+	if (mode != nullptr && mode->refresh_rate_numerator > 0) {
+		return { mode->refresh_rate_numerator, mode->refresh_rate_denominator };
+	} else if (mode != nullptr && mode->refresh_rate > 0.0f) {
+		// Some platforms only report the rate in floating point.
+		return { static_cast<int>(std::lround(mode->refresh_rate * 1000.0f)), 1000 };
+	}
+	return { 0, 0 };
+}
+
 bool is_app_input_priority_event(const SDL_Event &event) {
 	return is_keyboard_priority_event(event);
 }
 
+bool is_controller_input_event(const SDL_Event &event) {
+	using namespace robikzinputtest::sdl;
+	return is_keyboard_event(event) || is_joystick_event(event) || is_mouse_event(event);
+}
+
 } // namespace
 
 struct App::D
@@ -79,16 +181,115 @@ struct App::D
 
 	SDL_Window* window = nullptr;
 	SDL_Renderer* renderer = nullptr;
+	/// Recreate the renderer with the set driver at the start of the next frame.
+	bool render_driver_pending = false;
 
 	Settings settings;
+	SettingsProfiles settings_profiles;
+	std::unique_ptr<SettingsPersistence> settings_persistence;
+	DisplayRegistry display_registry;
 
 	OpenedJoysticksMap joysticks;
+	AxisResponse axis_response;
+	KeyboardAnalyzer keyboard_analyzer;
+	std::string keyboard_report_path;
+	std::string axis_report_path;
+	std::string frame_report_path;
+	JoystickSnapshotMap joystick_snapshots;
+	JoystickTimingMap joystick_timing;
+	JoystickAxisNoiseMap joystick_axis_noise;
+	JoystickSensorMap joystick_sensors;
+
+	/// Statistics of an unplugged joystick, kept for when it comes back.
+	struct RetiredJoystick {
+		InputTiming timing;
+		AxisNoiseAnalyzer axis_noise;
+		SensorCapture sensors;
+	};
+	/// By the controller identifier.
+	std::map<std::string, RetiredJoystick> retired_joysticks;
+	MouseTimingMap mouse_timing;
 
 	std::unique_ptr<Arena> arena;
 	std::unique_ptr<ControllerSystem> controller_system;
 	std::unique_ptr<gui::Gui> gui;
 
+	std::unique_ptr<InputRecorder> input_recorder;
+	std::unique_ptr<InputReplay> input_replay;
+	std::unique_ptr<TrajectoryReport> trajectory_report;
+	std::unique_ptr<SelfTest> self_test;
+	std::unique_ptr<RenderBenchmark> render_benchmark;
+	std::unique_ptr<FrameCapture> frame_capture;
+	std::unique_ptr<SensorSimulator> sensor_simulator;
+
+	/// Is the gizmo of the self-test's joystick active.
+	bool is_self_test_gizmo_active() const {
+		return std::any_of(
+			arena->gizmos().begin(), arena->gizmos().end(),
+			[this](auto &gizmo) {
+				return gizmo->controller().type == ControllerId::TYPE_JOY
+					&& gizmo->controller().index == self_test->joystick_id()
+					&& gizmo->is_active();
+			}
+		);
+	}
+
+	/// The benchmark runs without vsync, whatever the setting.
+	int renderer_vsync() const {
+		return render_benchmark ? SDL_RENDERER_VSYNC_DISABLED : settings.vsync;
+	}
+
+	/**
+	 * The rate the frames are paced at, as a fraction; {0, 0} when
+	 * nothing paces them. Call after recalculate_fps_clock().
+	 */
+	std::pair<int, int> paced_frame_rate() const {
+		if (render_benchmark) {
+			return { 0, 0 };
+		}
+		const auto [refresh_numerator, refresh_denominator] = window_refresh_rate(window);
+		if (frame_pacer.enabled()) {
+			return { refresh_numerator, refresh_denominator * settings.refresh_divisor };
+		}
+		// VSync holds the frames to every Nth refresh, adaptive to each one.
+		const int vsync = renderer_vsync();
+		std::pair<int, int> vsync_rate { 0, 0 };
+		if (refresh_numerator > 0 && vsync != SDL_RENDERER_VSYNC_DISABLED) {
+			vsync_rate = { refresh_numerator, refresh_denominator * std::max(vsync, 1) };
+		}
+		if (settings.limit_fps) {
+			const std::pair<int, int> limit_rate { static_cast<int>(std::lround(settings.target_fps * 1000.0)), 1000 };
+			// The slower of the limit and the vsync wins.
+			if (
+				vsync_rate.first == 0 ||
+				static_cast<int64_t>(limit_rate.first) * vsync_rate.second <
+					static_cast<int64_t>(vsync_rate.first) * limit_rate.second
+			) {
+				return limit_rate;
+			}
+		}
+		return vsync_rate;
+	}
+
+	/// Forget the removed mouse: its controller, its gizmo and its timing.
+	void retire_mouse(SDL_MouseID which) {
+		if (const Controller *controller = controller_system->find_mouse(which)) {
+			if (std::shared_ptr<Gizmo> gizmo = arena->find_gizmo_for_controller(controller->id)) {
+				arena->remove_gizmo(gizmo);
+			}
+		}
+		controller_system->retire_mouse(which);
+		mouse_timing.erase(which);
+	}
+
 	EngineClock clock;
+	FramePacer frame_pacer;
+	EventRateMonitor event_rates;
+	FrameProfiler frame_profiler;
+	PresentTiming present_timing;
+	/// The vsync mismatch last told to the log.
+	bool present_mismatch_logged = false;
+	StartupTimer startup;
 
 	D()
 	{
@@ -107,12 +308,18 @@ App::~App()
 
 AppRunResult App::init(int argc, char *argv[])
 {
-	(void)argc;
-	(void)argv;
-
 	// Hello App.
 	std::cerr << app_full_signature() << std::endl;
 
+	// Parse the command line
+	const auto command_line = parse_command_line(argc, argv);
+	const CommandLineOptions &options = command_line.second;
+	if (!command_line.first || options.show_help) {
+		std::cout << command_line_usage(argc > 0 ? argv[0] : app_identifier_appname());
+		return command_line.first ? AppRunResult::SUCCESS : AppRunResult::FAILURE;
+	}
+	d->startup.mark("command line");
+
 	// Set application metadata
 	SDL_SetAppMetadata(
 		app_name().c_str(),
@@ -128,22 +335,93 @@ AppRunResult App::init(int argc, char *argv[])
 		app_copyright().c_str()
 	);
 
-	// Initialize SDL
-	if (!SDL_Init(SDL_INIT_VIDEO | SDL_INIT_JOYSTICK)) {
+	// SDL's own state, which the storage calls use from the loading thread,
+	// must be set up on the main thread first; the subsystems come after.
+	if (!SDL_Init(0)) {
 		std::cerr << "SDL_Init Error: " << SDL_GetError() << std::endl;
 		return AppRunResult::FAILURE;
 	}
 
-	// Load settings
-	sdl::SettingsSdlIO settings_io;
-	auto settings_load_result = settings_io.load();
-	d->settings = settings_load_result.second;
+	// Load the settings profiles while the subsystems initialize; the storage doesn't need them.
+	struct LoadedSettings {
+		std::map<std::string, Settings> profiles;
+		/// The default profile came from a file; false on the first run.
+		bool default_from_file = false;
+		StartupSpan span;
+	};
+	std::future<LoadedSettings> settings_loading = std::async(std::launch::async, []() {
+		LoadedSettings loaded;
+		loaded.span.begin_ns = SDL_GetTicksNS();
+		auto default_result = sdl::SettingsSdlIO().load();
+		loaded.profiles[SettingsProfiles::DEFAULT_PROFILE] = std::move(default_result.second);
+		loaded.default_from_file = default_result.first;
+		for (const std::string &profile : sdl::SettingsSdlIO::list_profiles()) {
+			auto result = sdl::SettingsSdlIO(profile).load();
+			if (result.first) {
+				loaded.profiles[profile] = std::move(result.second);
+			}
+		}
+		loaded.span.end_ns = SDL_GetTicksNS();
+		return loaded;
+	});
+
+	// Initialize SDL
+	if (!SDL_InitSubSystem(SDL_INIT_VIDEO | SDL_INIT_JOYSTICK | SDL_INIT_GAMEPAD)) {
+		std::cerr << "SDL_InitSubSystem Error: " << SDL_GetError() << std::endl;
+		return AppRunResult::FAILURE;
+	}
+	d->display_registry.refresh();
+	d->startup.mark("SDL init");
+
+	// Prepare input session recording or replay
+	if (!options.record_path.empty()) {
+		d->input_recorder = std::make_unique<InputRecorder>();
+		if (!d->input_recorder->open(options.record_path)) {
+			return AppRunResult::FAILURE;
+		}
+	}
+	if (!options.replay_path.empty()) {
+		d->input_replay = std::make_unique<InputReplay>();
+		if (!d->input_replay->open(options.replay_path)) {
+			return AppRunResult::FAILURE;
+		}
+	}
+	d->keyboard_report_path = options.keyboard_report_path;
+	d->axis_report_path = options.axis_report_path;
+	d->frame_report_path = options.frame_report_path;
+	if (!options.report_path.empty()) {
+		d->trajectory_report = std::make_unique<TrajectoryReport>();
+		if (!d->trajectory_report->open(options.report_path)) {
+			return AppRunResult::FAILURE;
+		}
+	}
+	d->startup.mark("session files");
+
+	// Take the loaded settings
+	LoadedSettings loaded_settings = settings_loading.get();
+	d->startup.add_parallel("settings load", loaded_settings.span);
+	for (const auto &profile : loaded_settings.profiles) {
+		d->settings_profiles.set(profile.first, profile.second);
+	}
+	d->settings = loaded_settings.profiles[SettingsProfiles::DEFAULT_PROFILE];
+	d->startup.mark("settings wait");
+	d->settings_persistence = std::make_unique<SettingsPersistence>(
+		std::make_unique<sdl::SettingsSdlIO>(), d->settings, loaded_settings.default_from_file);
+	if (!options.profile.empty()) {
+		const bool switched = d->settings_profiles.has(options.profile)
+			? switch_profile(options.profile)
+			: create_profile(options.profile);
+		if (!switched) {
+			return AppRunResult::FAILURE;
+		}
+	}
 
 	// Initialize controller system
 	d->controller_system = std::make_unique<ControllerSystem>(*this);
 
 	// Limit clock to target FPS
 	recalculate_fps_clock();
+	recalculate_axis_response();
 
 	// Create the window
 	// Correct the window size first if the saved settings are invalid.
@@ -164,11 +442,19 @@ AppRunResult App::init(int argc, char *argv[])
 		std::cerr << "SDL_CreateWindow Error: " << SDL_GetError() << std::endl;
 		return AppRunResult::FAILURE;
 	}
+	d->startup.mark("window");
 
 	// Create a renderer
-	d->renderer = SDL_CreateRenderer(d->window, nullptr);
+	if (options.benchmark_renderers) {
+		// Before the renderer, so that it runs unthrottled from the start.
+		d->render_benchmark = std::make_unique<RenderBenchmark>();
+		if (!d->render_benchmark->valid()) {
+			std::cerr << "Failed to start the render benchmark: " << SDL_GetError() << std::endl;
+			return AppRunResult::FAILURE;
+		}
+	}
+	create_renderer(d->settings.render_driver);
 	if (d->renderer == nullptr) {
-		std::cerr << "SDL_CreateRenderer Error: " << SDL_GetError() << std::endl;
 		return AppRunResult::FAILURE;
 	}
 
@@ -177,17 +463,17 @@ AppRunResult App::init(int argc, char *argv[])
 	// of the window in WINDOWED mode is not restored properly for some reason.
 	load_window_video_settings(d->settings, d->window);
 
-	// Load VSync setting
-	if (!SDL_SetRenderVSync(d->renderer, d->settings.vsync)) {
-		std::cerr << "Failed to initialize VSync: " << SDL_GetError() << std::endl;
-		// non-fatal error; continue
-	}
+	// Now that the display is known.
+	recalculate_fps_clock();
+	d->startup.mark("renderer");
 
 	// Create GUI
 	d->gui = std::make_unique<gui::Gui>(*this, *d->window, *d->renderer);
 	if (!d->gui->init()) {
 		return AppRunResult::FAILURE;
 	}
+	d->gui->set_measurement_mode(options.measurement_mode);
+	d->startup.mark("GUI");
 
 	// Create the arena
 	d->arena = std::make_unique<Arena>(*this);
@@ -196,6 +482,33 @@ AppRunResult App::init(int argc, char *argv[])
 	SDL_Point window_size;
 	SDL_GetWindowSize(d->window, &window_size.x, &window_size.y);
 	d->arena->set_bounds({ 0, 0, window_size.x, window_size.y });
+	d->startup.mark("arena");
+
+	// Start the self-test
+	if (options.self_test) {
+		d->self_test = std::make_unique<SelfTest>();
+		if (!d->self_test->valid()) {
+			std::cerr << "Failed to start the self-test: " << SDL_GetError() << std::endl;
+			return AppRunResult::FAILURE;
+		}
+	}
+	if (!options.capture_path.empty()) {
+		const auto [rate_numerator, rate_denominator] = d->paced_frame_rate();
+		if (rate_numerator == 0) {
+			std::cerr << "Frame capture: the frames aren't paced, so the video's rate is a guess" << std::endl;
+		}
+		d->frame_capture = std::make_unique<FrameCapture>(options.capture_every);
+		if (!d->frame_capture->open(options.capture_path, rate_numerator, rate_denominator)) {
+			return AppRunResult::FAILURE;
+		}
+	}
+	if (options.virtual_sensors) {
+		d->sensor_simulator = std::make_unique<SensorSimulator>();
+		if (!d->sensor_simulator->valid()) {
+			std::cerr << "Failed to attach the virtual sensors: " << SDL_GetError() << std::endl;
+			return AppRunResult::FAILURE;
+		}
+	}
 
 	return AppRunResult::CONTINUE;
 }
@@ -203,11 +516,44 @@ AppRunResult App::init(int argc, char *argv[])
 AppRunResult App::run()
 {
 	while (d->main_loop_result == AppRunResult::CONTINUE) {
-		FrameTime frame_time = d->clock.tick();
+		if (d->input_replay && d->input_replay->is_finished()) {
+			d->logger.info() << "Input replay finished" << std::endl;
+			return AppRunResult::SUCCESS;
+		}
+		if (d->self_test && d->self_test->is_finished()) {
+			const bool measured = d->self_test->write_summary(std::cout);
+			return measured ? AppRunResult::SUCCESS : AppRunResult::FAILURE;
+		}
+		if (d->render_benchmark) {
+			if (d->render_benchmark->is_finished()) {
+				const bool measured = d->render_benchmark->write_summary(std::cout);
+				return measured ? AppRunResult::SUCCESS : AppRunResult::FAILURE;
+			}
+			if (d->render_benchmark->needs_driver()) {
+				const std::string driver = d->render_benchmark->next_driver();
+				d->logger.info() << "Benchmarking render driver " << driver << std::endl;
+				if (!create_renderer(driver)) {
+					d->render_benchmark->driver_failed();
+				}
+				continue;
+			}
+		}
+		if (!d->input_replay) {
+			d->frame_pacer.wait();
+		}
+		// A replay runs on the recording's timeline instead of the clock.
+		FrameTime frame_time = d->input_replay
+			? d->input_replay->wait_next_frame()
+			: d->clock.tick();
+		if (d->input_recorder) {
+			d->input_recorder->record_frame(frame_time);
+		}
+		d->frame_profiler.begin_frame(SDL_GetTicksNS());
 		const AppRunResult event_result = handleEvents(frame_time);
 		if (event_result != AppRunResult::CONTINUE) {
 			return event_result;
 		}
+		d->frame_profiler.end_phase(FramePhase::EVENTS, SDL_GetTicksNS());
 		const AppRunResult iterate_result = iterate(frame_time);
 		if (iterate_result != AppRunResult::CONTINUE) {
 			return iterate_result;
@@ -224,16 +570,99 @@ AppRunResult App::handleEvents(const FrameTime &frame_time)
 		if (d->arena->find_gizmo_for_controller(controller.id) == nullptr) {
 			std::cerr << "Creating gizmo for " << controller.id.identifier << " controller." << std::endl;
 			d->arena->create_gizmo(controller.id);
+			if (d->input_recorder) {
+				d->input_recorder->record_spawn(controller.id);
+			}
 		}
 	};
 
+	// Inject the self-test's input, to be picked up with the other events.
+	if (d->self_test) {
+		d->self_test->begin_frame();
+	}
+	if (d->sensor_simulator) {
+		d->sensor_simulator->begin_frame();
+	}
+	if (d->render_benchmark) {
+		d->render_benchmark->begin_frame();
+	}
+
+	// Replayed input goes directly to the controllers.
+	if (d->input_replay) {
+		d->input_replay->play_frame(
+			[this](const SDL_Event &event) {
+				if (event.type == SDL_EVENT_MOUSE_REMOVED) {
+					d->retire_mouse(event.mdevice.which);
+					return;
+				}
+				d->controller_system->handle_event(event);
+			},
+			[this, &spawn_controller_gizmo](const ControllerId &controller_id) {
+				if (controller_id.type == ControllerId::TYPE_KEYBOARD) {
+					spawn_controller_gizmo(d->controller_system->for_keyboard());
+				} else if (controller_id.type == ControllerId::TYPE_JOY) {
+					spawn_controller_gizmo(d->controller_system->for_joystick(controller_id.index));
+				} else if (controller_id.type == ControllerId::TYPE_MOUSE) {
+					spawn_controller_gizmo(d->controller_system->for_mouse(controller_id.index));
+				}
+			}
+		);
+	}
+
 	SDL_Event event;
 	while (SDL_PollEvent(&event)) {
+		if (
+			d->display_registry.handle_event(event)
+			|| event.type == SDL_EVENT_WINDOW_DISPLAY_CHANGED
+		) {
+			// The refresh rate may have changed.
+			recalculate_fps_clock();
+		}
+		// Measure every report of the device, even if it ends up unused.
+		if (sdl::is_keyboard_event(event)) {
+			d->keyboard_analyzer.handle_event(event);
+			d->event_rates.add_event(InputDeviceKind::KEYBOARD, event.key.which);
+		} else if (sdl::is_joystick_event(event)) {
+			d->event_rates.add_event(InputDeviceKind::JOYSTICK, event.jdevice.which);
+			auto timing = d->joystick_timing.find(event.jdevice.which);
+			if (timing != d->joystick_timing.end()) {
+				timing->second.add_event(event);
+			}
+			auto axis_noise = d->joystick_axis_noise.find(event.jdevice.which);
+			if (axis_noise != d->joystick_axis_noise.end()) {
+				axis_noise->second.handle_event(event);
+			}
+			auto snapshot = d->joystick_snapshots.find(event.jdevice.which);
+			if (snapshot != d->joystick_snapshots.end()) {
+				snapshot->second.handle_event(event);
+			}
+		} else if (event.type == SDL_EVENT_GAMEPAD_SENSOR_UPDATE) {
+			auto sensors = d->joystick_sensors.find(event.gsensor.which);
+			if (sensors != d->joystick_sensors.end()) {
+				sensors->second.handle_event(event);
+			}
+		} else if (is_physical_mouse_event(event)) {
+			d->mouse_timing[sdl::get_mouse_event_which(event)].add_event(event);
+			d->event_rates.add_event(InputDeviceKind::MOUSE, sdl::get_mouse_event_which(event));
+		}
+		// Give the mouse back.
+		if (is_mouse_release_key(event) && SDL_GetWindowRelativeMouseMode(d->window)) {
+			SDL_SetWindowRelativeMouseMode(d->window, false);
+			continue;
+		}
 		// Pass the events to ImGUI first
 		const bool handled_by_gui = d->gui->handle_event(event);
 		if (handled_by_gui && !is_app_input_priority_event(event)) {
 			continue;
 		}
+		// Live input must not disturb a replayed session.
+		if (
+			d->input_replay
+			&& is_controller_input_event(event)
+			&& !is_app_input_priority_event(event)
+		) {
+			continue;
+		}
 		// Handle app events
 		switch (event.type) {
 		case SDL_EVENT_QUIT:
@@ -241,6 +670,9 @@ AppRunResult App::handleEvents(const FrameTime &frame_time)
 		case SDL_EVENT_KEY_DOWN:
 			if (is_quit_key(event.key)) {
 				return AppRunResult::SUCCESS;
+			} else if (is_next_profile_key(event.key)) {
+				switch_profile(d->settings_profiles.next());
+				continue;
 			} else if (is_alt_enter(event.key)) {
 				// Toggle fullscreen
 				const auto flags = SDL_GetWindowFlags(d->window);
@@ -278,6 +710,22 @@ AppRunResult App::handleEvents(const FrameTime &frame_time)
 		case SDL_EVENT_WINDOW_RESTORED:
 			settings().windowed_maximized = sdl::is_window_maximized(d->window);
 			break;
+		case SDL_EVENT_MOUSE_BUTTON_DOWN:
+			if (is_physical_mouse_event(event) && is_mouse_gizmo_create_button(event.button)) {
+				Controller &controller = d->controller_system->for_mouse(event.button.which);
+				spawn_controller_gizmo(controller);
+				// Relative mode delivers the raw, unaccelerated motion.
+				SDL_SetWindowRelativeMouseMode(d->window, true);
+			}
+			break;
+		case SDL_EVENT_MOUSE_REMOVED:
+			// The replayed mice are the recording's, not the live ones.
+			if (d->input_replay) {
+				d->mouse_timing.erase(event.mdevice.which);
+			} else {
+				d->retire_mouse(event.mdevice.which);
+			}
+			break;
 		case SDL_EVENT_JOYSTICK_ADDED:
 		case SDL_EVENT_JOYSTICK_REMOVED:
 			d->logger.info() <<
@@ -299,9 +747,54 @@ AppRunResult App::handleEvents(const FrameTime &frame_time)
 							JoystickUPtr(joystick, &SDL_CloseJoystick)
 						}
 					);
+					// A reconnected joystick continues its statistics.
+					const Controller &controller = d->controller_system->for_joystick(event.jdevice.which);
+					InputTiming &timing = d->joystick_timing[event.jdevice.which];
+					AxisNoiseAnalyzer &axis_noise = d->joystick_axis_noise[event.jdevice.which];
+					SensorCapture &sensors = d->joystick_sensors[event.jdevice.which];
+					auto retired = d->retired_joysticks.find(controller.id.identifier);
+					if (retired != d->retired_joysticks.end()) {
+						timing = std::move(retired->second.timing);
+						axis_noise = std::move(retired->second.axis_noise);
+						sensors = std::move(retired->second.sensors);
+						d->retired_joysticks.erase(retired);
+					} else {
+						timing.clear();
+						axis_noise.clear();
+						sensors.clear();
+					}
+					axis_noise.open(joystick);
+					d->joystick_snapshots[event.jdevice.which].open(event.jdevice.which, joystick);
+					if (d->input_recorder) {
+						d->input_recorder->record_joystick_added(event.jdevice.which, joystick);
+					}
 				}
 			} else if (event.type == SDL_EVENT_JOYSTICK_REMOVED) {
+				const Controller *controller = d->controller_system->find_joystick(event.jdevice.which);
+				if (controller != nullptr) {
+					D::RetiredJoystick &retired = d->retired_joysticks[controller->id.identifier];
+					auto timing = d->joystick_timing.find(event.jdevice.which);
+					if (timing != d->joystick_timing.end()) {
+						retired.timing = std::move(timing->second);
+					}
+					auto axis_noise = d->joystick_axis_noise.find(event.jdevice.which);
+					if (axis_noise != d->joystick_axis_noise.end()) {
+						retired.axis_noise = std::move(axis_noise->second);
+					}
+					auto sensors = d->joystick_sensors.find(event.jdevice.which);
+					if (sensors != d->joystick_sensors.end()) {
+						retired.sensors = std::move(sensors->second);
+					}
+				}
+				d->controller_system->retire_joystick(event.jdevice.which);
 				d->joysticks.erase(event.jdevice.which);
+				d->joystick_timing.erase(event.jdevice.which);
+				d->joystick_axis_noise.erase(event.jdevice.which);
+				d->joystick_sensors.erase(event.jdevice.which);
+				d->joystick_snapshots.erase(event.jdevice.which);
+				if (d->input_recorder) {
+					d->input_recorder->record_joystick_removed(event.jdevice.which);
+				}
 			}
 			break;
 		case SDL_EVENT_JOYSTICK_AXIS_MOTION: {
@@ -355,6 +848,9 @@ AppRunResult App::handleEvents(const FrameTime &frame_time)
 			break;
 		}
 		// Now pass the event to controllers
+		if (d->input_recorder) {
+			d->input_recorder->record_event(event);
+		}
 		d->controller_system->handle_event(event);
 	}
 	return AppRunResult::CONTINUE;
@@ -362,6 +858,13 @@ AppRunResult App::handleEvents(const FrameTime &frame_time)
 
 AppRunResult App::iterate(const FrameTime &frame_time)
 {
+	const Uint64 frame_ns = SDL_GetTicksNS();
+	// A driver changed through the GUI is applied outside of its frame.
+	if (d->render_driver_pending) {
+		d->render_driver_pending = false;
+		create_renderer(d->settings.render_driver);
+	}
+
 	// Background color setup.
 	const Color base_bgcolor = d->settings.background_color;
 	const bool is_bgcolor_light = base_bgcolor.is_light();
@@ -387,6 +890,7 @@ AppRunResult App::iterate(const FrameTime &frame_time)
 
 	// Update arena
 	d->arena->update(*d->controller_system, frame_time);
+	d->frame_profiler.end_phase(FramePhase::UPDATE, SDL_GetTicksNS());
 
 	// Clear the screen with a color
 	auto bgcolor = ColorU8<uint8_t>::from(colors[color_cycle_index]);
@@ -404,20 +908,130 @@ AppRunResult App::iterate(const FrameTime &frame_time)
 
 	// Draw the arena
 	d->arena->render(*d->renderer);
+	d->frame_profiler.end_phase(FramePhase::RENDER, SDL_GetTicksNS());
 
 	// Draw GUI
-	d->gui->iterate(frame_time);
+	const GuiFrame gui_frame = d->gui->iterate(frame_time);
+	d->frame_profiler.end_phase(FramePhase::GUI, SDL_GetTicksNS());
+	d->frame_profiler.gui_frame(gui_frame);
+
+	// The self-test's marker goes over everything.
+	if (d->self_test) {
+		d->self_test->check_frame(*d->renderer, d->is_self_test_gizmo_active());
+	}
+	if (d->frame_capture) {
+		d->frame_capture->capture(*d->renderer);
+	}
 
 	// Present the backbuffer
+	const Uint64 submit_ns = SDL_GetTicksNS();
+	d->frame_profiler.end_phase(FramePhase::READBACK, submit_ns);
 	SDL_RenderPresent(d->renderer);
+	const Uint64 present_ns = SDL_GetTicksNS();
+	d->frame_profiler.end_phase(FramePhase::PRESENT, present_ns);
+	d->frame_pacer.presented(submit_ns, present_ns);
+	if (d->present_timing.presented(submit_ns, present_ns)) {
+		const PresentTimingReport &present_report = d->present_timing.report();
+		if (present_report.mismatch != d->present_mismatch_logged) {
+			d->present_mismatch_logged = present_report.mismatch;
+			if (present_report.mismatch) {
+				d->logger.error() << "VSync is set to "
+					<< get_vsync_state_label(d->present_timing.configured_vsync())
+					<< ", but the presents are "
+					<< observed_vsync_label(present_report.observed)
+					<< " (" << present_report.interval_p50_ms << " ms apart)" << std::endl;
+			}
+		}
+	}
+	if (d->self_test) {
+		d->self_test->frame_presented(present_ns);
+	}
+	if (d->render_benchmark) {
+		d->render_benchmark->frame_presented(frame_ns, submit_ns, present_ns);
+	}
+	// The frame's latency is that of its longest-waiting input.
+	bool frame_had_input = false;
+	uint64_t frame_latency_us = 0;
+	auto input_presented = [&](LatencyTracker &latency) {
+		if (latency.presented(present_ns)) {
+			frame_had_input = true;
+			frame_latency_us = std::max(frame_latency_us, latency.last_us());
+		}
+	};
+	for (auto &timing : d->joystick_timing) {
+		input_presented(timing.second.latency);
+	}
+	for (auto &timing : d->mouse_timing) {
+		input_presented(timing.second.latency);
+	}
+	if (frame_had_input) {
+		d->frame_profiler.input_latency(frame_latency_us);
+	}
+	// Recorded after the present, so the row carries the frame's latency.
+	if (d->trajectory_report) {
+		d->trajectory_report->record(
+			frame_time, *d->arena,
+			frame_had_input ? std::optional<uint64_t>(frame_latency_us) : std::nullopt
+		);
+	}
+	d->event_rates.update(present_ns);
+	for (auto &sensors : d->joystick_sensors) {
+		sensors.second.presented(present_ns);
+	}
+	d->controller_system->frame_presented(present_ns);
+	if (d->startup.first_frame_presented(present_ns)) {
+		// Into the program log only; it's of no use on every launch's console.
+		d->startup.write_report(d->logger.info());
+	}
+
+	d->settings_persistence->update(d->settings, present_ns);
 
 	return AppRunResult::CONTINUE;
 }
 
 void App::close()
 {
+	d->input_recorder.reset();
+	d->input_replay.reset();
+	d->trajectory_report.reset();
+	d->self_test.reset();
+	d->render_benchmark.reset();
+	d->frame_capture.reset();
+	d->sensor_simulator.reset();
 	d->arena.reset();
+
+	if (!d->keyboard_report_path.empty()) {
+		std::ofstream keyboard_report(d->keyboard_report_path);
+		d->keyboard_analyzer.write_csv(keyboard_report);
+		if (!keyboard_report) {
+			std::cerr << "Failed to write keyboard report: " << d->keyboard_report_path << std::endl;
+		}
+	}
+	if (!d->axis_report_path.empty()) {
+		std::ofstream axis_report(d->axis_report_path);
+		AxisNoiseAnalyzer::write_csv_header(axis_report);
+		for (const auto &it : d->joystick_axis_noise) {
+			const Controller *controller = d->controller_system->find_joystick(it.first);
+			if (controller != nullptr) {
+				it.second.write_csv(axis_report, controller->id.identifier.c_str());
+			}
+		}
+		for (const auto &it : d->retired_joysticks) {
+			it.second.axis_noise.write_csv(axis_report, it.first.c_str());
+		}
+		if (!axis_report) {
+			std::cerr << "Failed to write axis report: " << d->axis_report_path << std::endl;
+		}
+	}
 	d->controller_system.reset();
+	// Only on the first close, when the app has run.
+	if (d->gui && !d->frame_report_path.empty()) {
+		std::ofstream frame_report(d->frame_report_path);
+		d->frame_profiler.write_report(frame_report);
+		if (!frame_report) {
+			std::cerr << "Failed to write frame report: " << d->frame_report_path << std::endl;
+		}
+	}
 	d->gui.reset();
 
 	if (d->renderer) {
@@ -429,10 +1043,10 @@ void App::close()
 		d->window = nullptr;
 	}
 
-	// Save settings.
-	sdl::SettingsSdlIO settings_io;
-	if (!settings_io.save(d->settings)) {
-		std::cerr << "Failed to save settings" << std::endl;
+	// Save settings and wait for the writes to finish.
+	if (d->settings_persistence) {
+		d->settings_persistence->save(d->settings);
+		d->settings_persistence.reset();
 	}
 
 	SDL_Quit();
@@ -442,7 +1056,161 @@ void App::quit() {
 	d->main_loop_result = AppRunResult::SUCCESS;
 }
 
+bool App::switch_profile(const std::string &name) {
+	if (name == d->settings_profiles.active()) {
+		return true;
+	}
+	const Settings previous = d->settings;
+	if (!d->settings_profiles.switch_to(name, d->settings)) {
+		d->logger.error() << "No such settings profile: " << name << std::endl;
+		return false;
+	}
+	d->settings_persistence->switch_to(
+		std::make_unique<sdl::SettingsSdlIO>(name), d->settings, true);
+	apply_changed_settings(previous);
+	d->logger.info() << "Switched to settings profile: " << name << std::endl;
+	return true;
+}
+
+bool App::create_profile(const std::string &name) {
+	if (!SettingsProfiles::is_valid_name(name)) {
+		d->logger.error() << "Invalid settings profile name: " << name << std::endl;
+		return false;
+	}
+	if (d->settings_profiles.has(name)) {
+		d->logger.error() << "Settings profile already exists: " << name << std::endl;
+		return false;
+	}
+	// The new profile starts as a copy of the running settings.
+	d->settings_profiles.set(name, d->settings);
+	d->settings_profiles.switch_to(name, d->settings);
+	d->settings_persistence->switch_to(
+		std::make_unique<sdl::SettingsSdlIO>(name), d->settings, false);
+	d->logger.info() << "Created settings profile: " << name << std::endl;
+	return true;
+}
+
+const SettingsProfiles &App::settings_profiles() const {
+	return d->settings_profiles;
+}
+
+void App::apply_changed_settings(const Settings &previous) {
+	if (
+		d->settings.limit_fps != previous.limit_fps
+		|| d->settings.target_fps != previous.target_fps
+		|| d->settings.lock_to_refresh_rate != previous.lock_to_refresh_rate
+		|| d->settings.refresh_divisor != previous.refresh_divisor
+		|| d->settings.vsync != previous.vsync
+	) {
+		recalculate_fps_clock();
+	}
+	if (axis_response_settings_differ(d->settings, previous)) {
+		recalculate_axis_response();
+	}
+	if (d->renderer && d->settings.render_driver != previous.render_driver) {
+		d->render_driver_pending = true;
+	}
+	// Before the window is created, it's made from the settings anyway.
+	if (d->renderer && d->settings.vsync != previous.vsync) {
+		if (!SDL_SetRenderVSync(d->renderer, d->renderer_vsync())) {
+			d->logger.error() << "Failed to change vsync: " << SDL_GetError() << std::endl;
+		}
+	}
+	if (d->window && video_settings_differ(d->settings, previous)) {
+		load_window_video_settings(d->settings, d->window);
+	}
+}
+
+bool App::set_vsync(int vsync) {
+	const int previous = d->settings.vsync;
+	d->settings.vsync = vsync;
+	if (d->renderer && !SDL_SetRenderVSync(d->renderer, d->renderer_vsync())) {
+		d->settings.vsync = previous;
+		return false;
+	}
+	// The frame pacing locks its phase with vsync only.
+	recalculate_fps_clock();
+	return true;
+}
+
+void App::set_render_driver(const std::string &driver) {
+	d->settings.render_driver = driver;
+	d->render_driver_pending = true;
+}
+
+bool App::create_renderer(const std::string &driver) {
+	if (d->gui) {
+		d->gui->release_renderer();
+	}
+	if (d->renderer) {
+		SDL_DestroyRenderer(d->renderer);
+		d->renderer = nullptr;
+	}
+
+	bool created = true;
+	d->renderer = SDL_CreateRenderer(d->window, driver.empty() ? nullptr : driver.c_str());
+	if (d->renderer == nullptr && !driver.empty()) {
+		d->logger.error() << "Failed to create the " << driver << " renderer: "
+			<< SDL_GetError() << "; letting SDL pick one" << std::endl;
+		created = false;
+		d->renderer = SDL_CreateRenderer(d->window, nullptr);
+	}
+	if (d->renderer == nullptr) {
+		std::cerr << "SDL_CreateRenderer Error: " << SDL_GetError() << std::endl;
+		return false;
+	}
+	d->logger.info() << "Renderer: " << SDL_GetRendererName(d->renderer) << std::endl;
+
+	if (!SDL_SetRenderVSync(d->renderer, d->renderer_vsync())) {
+		d->logger.error() << "Failed to set VSync: " << SDL_GetError() << std::endl;
+		// non-fatal error; continue
+	}
+	// The GUI and the arena are made after the first renderer.
+	if (d->gui && !d->gui->attach_renderer(*d->renderer)) {
+		d->logger.error() << "Failed to attach the GUI to the renderer" << std::endl;
+	}
+	if (d->arena) {
+		d->arena->load_render(*d->renderer);
+		// The presents of another driver are observed anew.
+		recalculate_fps_clock();
+	}
+	return created;
+}
+
+void App::recalculate_axis_response() {
+	d->axis_response.set_curve(AxisResponseCurve::from_settings(d->settings));
+}
+
 void App::recalculate_fps_clock() {
+	// Without a window yet, the display is known only once it's made.
+	const auto [refresh_numerator, refresh_denominator] = window_refresh_rate(d->window);
+	// Whatever paces the frames now, the presents are observed anew.
+	d->present_timing.expect(d->renderer_vsync(), refresh_numerator, refresh_denominator);
+	d->present_mismatch_logged = false;
+
+	if (d->render_benchmark) {
+		// The benchmark measures the drivers unthrottled.
+		d->frame_pacer.disable();
+		d->clock.set_resolution(std::chrono::nanoseconds::zero());
+		return;
+	}
+
+	if (d->settings.lock_to_refresh_rate) {
+		d->settings.refresh_divisor = std::clamp(d->settings.refresh_divisor, 1, FramePacer::MAX_DIVISOR);
+		if (
+			d->frame_pacer.set_rate(
+				refresh_numerator,
+				refresh_denominator,
+				d->settings.refresh_divisor,
+				d->renderer_vsync() != 0
+			)
+		) {
+			// The pacer keeps the time; the clock only measures it.
+			d->clock.set_resolution(std::chrono::nanoseconds::zero());
+			return;
+		}
+	}
+	d->frame_pacer.disable();
 	if (d->settings.limit_fps) {
 		const double reasonably_clamped_target_fps = std::max<double>(10.0, d->settings.target_fps);
 		d->settings.target_fps = reasonably_clamped_target_fps;
@@ -460,10 +1228,42 @@ Arena &App::arena() {
 	return *d->arena;
 }
 
+const DisplayRegistry &App::display_registry() const {
+	return d->display_registry;
+}
+
+const FramePacer &App::frame_pacer() const {
+	return d->frame_pacer;
+}
+
+const EventRateMonitor &App::event_rates() const {
+	return d->event_rates;
+}
+
+const FrameProfiler &App::frame_profiler() const {
+	return d->frame_profiler;
+}
+
+const PresentTiming &App::present_timing() const {
+	return d->present_timing;
+}
+
+const AxisResponse &App::axis_response() const {
+	return d->axis_response;
+}
+
+const KeyboardAnalyzer &App::keyboard_analyzer() const {
+	return d->keyboard_analyzer;
+}
+
 Logger &App::logger() {
 	return d->logger;
 }
 
+const ControllerSystem &App::controller_system() const {
+	return *d->controller_system;
+}
+
 Settings &App::settings() {
 	return d->settings;
 }
@@ -472,6 +1272,26 @@ const OpenedJoysticksMap &App::joysticks() const {
 	return d->joysticks;
 }
 
+const JoystickSnapshotMap &App::joystick_snapshots() const {
+	return d->joystick_snapshots;
+}
+
+const JoystickTimingMap &App::joystick_timing() const {
+	return d->joystick_timing;
+}
+
+const JoystickAxisNoiseMap &App::joystick_axis_noise() const {
+	return d->joystick_axis_noise;
+}
+
+const JoystickSensorMap &App::joystick_sensors() const {
+	return d->joystick_sensors;
+}
+
+const MouseTimingMap &App::mouse_timing() const {
+	return d->mouse_timing;
+}
+
 SDL_Renderer *App::renderer() const {
 	return d->renderer;
 }
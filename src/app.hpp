@@ -7,16 +7,35 @@
 #include <functional>
 #include <map>
 #include <memory>
+#include <string>
 
 namespace robikzinputtest {
 
 class Arena;
+class AxisNoiseAnalyzer;
+class AxisResponse;
+class ControllerSystem;
+class DisplayRegistry;
+class EventRateMonitor;
+class FramePacer;
+class FrameProfiler;
+class KeyboardAnalyzer;
 class Logger;
+class PresentTiming;
+struct InputTiming;
+struct JoystickSnapshot;
+struct SensorCapture;
 struct Settings;
+class SettingsProfiles;
 struct VideoModeSettings;
 
 using JoystickUPtr = std::unique_ptr<SDL_Joystick, std::function<void(SDL_Joystick *)>>;
 using OpenedJoysticksMap = std::map<SDL_JoystickID, JoystickUPtr>;
+using JoystickSnapshotMap = std::map<SDL_JoystickID, JoystickSnapshot>;
+using JoystickTimingMap = std::map<SDL_JoystickID, InputTiming>;
+using JoystickAxisNoiseMap = std::map<SDL_JoystickID, AxisNoiseAnalyzer>;
+using JoystickSensorMap = std::map<SDL_JoystickID, SensorCapture>;
+using MouseTimingMap = std::map<SDL_MouseID, InputTiming>;
 
 enum class AppRunResult {
 	SUCCESS,
@@ -44,15 +63,64 @@ public:
 	void quit();
 	/// Limit the tickrate clock to target FPS.
 	void recalculate_fps_clock();
+	/// Rebuild the joystick axis response from the settings.
+	void recalculate_axis_response();
+	/// Make the named settings profile active and apply what it changes.
+	bool switch_profile(const std::string &name);
+	/// Make a new settings profile from the running settings and switch to it.
+	bool create_profile(const std::string &name);
+	/**
+	 * Change the vsync setting and apply it to the renderer, unless
+	 * something overrides it, like the render benchmark. On failure the
+	 * previous setting stays and false is returned, with the SDL error set.
+	 */
+	bool set_vsync(int vsync);
+	/**
+	 * Recreate the renderer, and what draws with it, with the named
+	 * render driver at the start of the next frame; empty lets SDL pick.
+	 */
+	void set_render_driver(const std::string &driver);
 
 	Arena &arena();
+	const AxisResponse &axis_response() const;
+	const ControllerSystem &controller_system() const;
+	/// Displays and their modes, refreshed on display events.
+	const DisplayRegistry &display_registry() const;
+	/// Refresh-rate-locked frame pacing, when enabled.
+	const FramePacer &frame_pacer() const;
+	/// Recent event rates of the input devices.
+	const EventRateMonitor &event_rates() const;
+	/// Per-phase cost of the recent frames.
+	const FrameProfiler &frame_profiler() const;
+	const KeyboardAnalyzer &keyboard_analyzer() const;
+	/// Present call timing and the vsync behavior seen from it.
+	const PresentTiming &present_timing() const;
 	Logger &logger();
 	Settings &settings();
+	const SettingsProfiles &settings_profiles() const;
 	const OpenedJoysticksMap &joysticks() const;
+	/// State of the opened joysticks as seen through their events.
+	const JoystickSnapshotMap &joystick_snapshots() const;
+	/// Polling rate and latency analysis of the opened joysticks.
+	const JoystickTimingMap &joystick_timing() const;
+	/// Axis noise, drift and resolution analysis of the opened joysticks.
+	const JoystickAxisNoiseMap &joystick_axis_noise() const;
+	/// Gyroscope and accelerometer samples of the opened gamepads.
+	const JoystickSensorMap &joystick_sensors() const;
+	/// Polling rate and latency analysis of the mice that sent input.
+	const MouseTimingMap &mouse_timing() const;
 	SDL_Renderer *renderer() const;
 	SDL_Window *window() const;
 
 private:
+	/// Re-apply the settings that differ from the previous ones.
+	void apply_changed_settings(const Settings &previous);
+	/**
+	 * Replace the renderer with one of the named render driver. If it
+	 * can't be made, SDL picks one instead and false is returned.
+	 */
+	bool create_renderer(const std::string &driver);
+
 	struct D;
 	std::unique_ptr<D> d;
 };
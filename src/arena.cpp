@@ -100,7 +100,11 @@ SDL_FPoint Arena::find_free_position() const {
 }
 
 void Arena::load_render(Renderer &renderer) {
-	// no-op
+	// A new renderer needs everything loaded again.
+	for (const auto &gizmo : m_gizmos) {
+		gizmo->renderer().load_render(renderer);
+	}
+	m_gizmos_to_load = {};
 }
 
 void Arena::render(Renderer &renderer) {
@@ -132,13 +136,34 @@ void Arena::update(ControllerSystem &controller_system, const FrameTime &frame_t
 			gizmo->controller()
 		);
 		if (controller) {
+			// The controller may have got reconnected as a new instance.
+			if (gizmo->controller().index != controller->id.index) {
+				gizmo->set_controller(controller->id);
+			}
 			// Update gizmo position based on controller state.
 			SDL_FPoint &pos = gizmo->m_position;
 			const SDL_FPoint &dir = controller->state.direction_vec2;
 			pos.x += dir.x * gizmo->m_speed * frame_time.delta_seconds;
 			pos.y += dir.y * gizmo->m_speed * frame_time.delta_seconds;
+			// Motion gets consumed.
+			SDL_FPoint &motion = controller->state.motion_vec2;
+			pos.x += motion.x;
+			pos.y += motion.y;
+			motion = { 0.0f, 0.0f };
 			// Clamp to arena bounds.
 			pos = clamp_to_bounds(pos);
+			// Show which of the buttons drive the action; the released
+			// ones still count for this frame.
+			gizmo->m_active_buttons.reset();
+			for (int channel = 0; channel < ControllerState::BUTTON_CHANNELS; ++channel) {
+				ButtonChannel &button = controller->state.buttons[channel];
+				if (button.state == ButtonState::RELEASED) {
+					gizmo->m_active_buttons.set(channel);
+					button.state = ButtonState::CLEAR;
+				} else if (button.state == ButtonState::PRESSED) {
+					gizmo->m_active_buttons.set(channel);
+				}
+			}
 			// If button is (continuously) PRESSED, update action time.
 			if (controller->state.button_primary == ButtonState::PRESSED) {
 				gizmo->m_action_started_at = frame_time;
@@ -151,6 +176,8 @@ void Arena::update(ControllerSystem &controller_system, const FrameTime &frame_t
 				// And clear the button state so that it doesn't get processed again.
 				controller->state.button_primary = ButtonState::CLEAR;
 			}
+		} else {
+			gizmo->m_active_buttons.reset();
 		}
 		// Clear action time if set and enough time has passed.
 		if (gizmo->m_action_started_at.has_value()) {
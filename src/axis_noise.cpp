@@ -0,0 +1,130 @@
+#include "axis_noise.hpp"
+
+#include "csv.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+
+namespace robikzinputtest {
+
+/*
+  AxisNoiseStats
+*/
+
+void AxisNoiseStats::add(int16_t value) {
+	if (!has_nominal) {
+		has_nominal = true;
+		nominal = value <= SDL_JOYSTICK_AXIS_MIN + REST_BAND ? SDL_JOYSTICK_AXIS_MIN : 0;
+		min = value;
+		max = value;
+	}
+
+	all.add(value);
+	min = std::min(min, value);
+	max = std::max(max, value);
+
+	const int32_t offset = static_cast<int32_t>(value) - nominal;
+	if (std::abs(offset) <= REST_BAND) {
+		if (rest.count == 0) {
+			rest_min = offset;
+			rest_max = offset;
+			rest_recent = offset;
+		}
+		rest.add(offset);
+		rest_min = std::min(rest_min, offset);
+		rest_max = std::max(rest_max, offset);
+		rest_recent += (offset - rest_recent) * REST_RECENT_WEIGHT;
+	}
+
+	const size_t index = static_cast<uint16_t>(value);
+	if (!seen.test(index)) {
+		seen.set(index);
+		++distinct;
+	}
+}
+
+double AxisNoiseStats::resolution_bits() const {
+	return distinct > 0 ? std::log2(static_cast<double>(distinct)) : 0.0;
+}
+
+int32_t AxisNoiseStats::suggested_deadzone() const {
+	if (rest.count < MIN_REST_SAMPLES) {
+		return 0;
+	}
+	// Four standard deviations past the drift catch nearly all of
+	// the noise; the envelope catches the rest.
+	const double noise = std::abs(rest.mean) + 4.0 * rest.stddev();
+	const int32_t envelope = std::max(std::abs(rest_min), std::abs(rest_max));
+	return std::min(
+		REST_BAND,
+		std::max(envelope, static_cast<int32_t>(std::ceil(noise))) + 1
+	);
+}
+
+/*
+  AxisNoiseAnalyzer
+*/
+
+void AxisNoiseAnalyzer::open(SDL_Joystick *joystick) {
+	SDL_LockJoysticks();
+	m_n_axes = std::max(m_n_axes, std::clamp(SDL_GetNumJoystickAxes(joystick), 0, MAX_AXES));
+	for (int axis = 0; axis < m_n_axes; ++axis) {
+		m_axes[axis].add(SDL_GetJoystickAxis(joystick, axis));
+	}
+	SDL_UnlockJoysticks();
+}
+
+void AxisNoiseAnalyzer::handle_event(const SDL_Event &event) {
+	if (event.type == SDL_EVENT_JOYSTICK_AXIS_MOTION && event.jaxis.axis < m_n_axes) {
+		m_axes[event.jaxis.axis].add(event.jaxis.value);
+	}
+}
+
+void AxisNoiseAnalyzer::clear() {
+	m_n_axes = 0;
+	m_axes.fill(AxisNoiseStats());
+}
+
+int32_t AxisNoiseAnalyzer::suggested_deadzone() const {
+	int32_t deadzone = 0;
+	for (int axis = 0; axis < m_n_axes; ++axis) {
+		if (!m_axes[axis].is_trigger()) {
+			deadzone = std::max(deadzone, m_axes[axis].suggested_deadzone());
+		}
+	}
+	return deadzone;
+}
+
+void AxisNoiseAnalyzer::write_csv_header(std::ostream &out) {
+	out << "device,axis,samples,mean,stddev,min,max,"
+		"nominal,rest_samples,rest_offset,rest_stddev,rest_min,rest_max,rest_recent,"
+		"distinct,resolution_bits,suggested_deadzone" << std::endl;
+}
+
+void AxisNoiseAnalyzer::write_csv(std::ostream &out, const char *device) const {
+	out << std::fixed << std::setprecision(3);
+	for (int axis = 0; axis < m_n_axes; ++axis) {
+		const AxisNoiseStats &stats = m_axes[axis];
+		write_csv_text(out, device);
+		out << ',' << axis
+			<< ',' << stats.all.count
+			<< ',' << stats.all.mean
+			<< ',' << stats.all.stddev()
+			<< ',' << stats.min
+			<< ',' << stats.max
+			<< ',' << stats.nominal
+			<< ',' << stats.rest.count
+			<< ',' << stats.rest.mean
+			<< ',' << stats.rest.stddev()
+			<< ',' << stats.rest_min
+			<< ',' << stats.rest_max
+			<< ',' << stats.rest_recent
+			<< ',' << stats.distinct
+			<< ',' << stats.resolution_bits()
+			<< ',' << stats.suggested_deadzone()
+			<< std::endl;
+	}
+}
+
+} // namespace robikzinputtest
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+
+#include <array>
+#include <bitset>
+#include <cmath>
+#include <cstdint>
+#include <ostream>
+
+namespace robikzinputtest {
+
+/**
+ * Running mean and variance in constant memory (Welford's algorithm).
+ */
+struct RunningStats {
+	uint64_t count = 0;
+	double mean = 0.0;
+	double m2 = 0.0;
+
+	void add(double value) {
+		++count;
+		const double delta = value - mean;
+		mean += delta / static_cast<double>(count);
+		m2 += delta * (value - mean);
+	}
+
+	double variance() const {
+		return count > 1 ? m2 / static_cast<double>(count - 1) : 0.0;
+	}
+
+	double stddev() const { return std::sqrt(variance()); }
+};
+
+/**
+ * Noise statistics of a single joystick axis.
+ *
+ * The axis rests at its nominal position: the center for sticks, the
+ * minimum for triggers, decided by the first value. The values near
+ * it are taken as the axis at rest; their spread is the noise, and
+ * their offset from the nominal position is the drift.
+ */
+struct AxisNoiseStats {
+	/// How far from the nominal position the axis still counts as at rest.
+	static constexpr int32_t REST_BAND = SDL_JOYSTICK_AXIS_MAX / 4;
+	/// Weight of the newest value in the recent rest position.
+	static constexpr double REST_RECENT_WEIGHT = 1.0 / 64.0;
+	/// Rest values needed before a deadzone is suggested.
+	static constexpr uint64_t MIN_REST_SAMPLES = 32;
+
+	bool has_nominal = false;
+	int32_t nominal = 0;
+
+	RunningStats all;
+	int16_t min = 0;
+	int16_t max = 0;
+
+	/// Offsets from the nominal position while at rest.
+	RunningStats rest;
+	int32_t rest_min = 0;
+	int32_t rest_max = 0;
+	/// Exponential average of the rest offset; follows a slow drift.
+	double rest_recent = 0.0;
+
+	/// Number of different values seen; the effective resolution.
+	uint32_t distinct = 0;
+	std::bitset<1 << 16> seen;
+
+	void add(int16_t value);
+
+	bool is_trigger() const { return nominal == SDL_JOYSTICK_AXIS_MIN; }
+	/// log2 of the distinct values.
+	double resolution_bits() const;
+	/**
+	 * Deadzone that covers the rest noise and drift of the axis,
+	 * or 0 if it wasn't at rest long enough.
+	 */
+	int32_t suggested_deadzone() const;
+};
+
+/**
+ * Streaming noise, drift and resolution analysis of the axes of
+ * a joystick, fed from the axis events.
+ */
+class AxisNoiseAnalyzer {
+public:
+	static constexpr int MAX_AXES = 16;
+
+	/// Take the current axis values of the just opened joystick.
+	void open(SDL_Joystick *joystick);
+	void handle_event(const SDL_Event &event);
+	void clear();
+
+	int n_axes() const { return m_n_axes; }
+	const AxisNoiseStats &axis(int axis) const { return m_axes[axis]; }
+	/// Largest suggested deadzone of the stick axes; 0 if none.
+	int32_t suggested_deadzone() const;
+
+	static void write_csv_header(std::ostream &out);
+	/// Write the statistics of every axis as CSV rows of the named device.
+	void write_csv(std::ostream &out, const char *device) const;
+
+private:
+	int m_n_axes = 0;
+	std::array<AxisNoiseStats, MAX_AXES> m_axes {};
+};
+
+} // namespace robikzinputtest
@@ -0,0 +1,96 @@
+#include "axis_response.hpp"
+
+#include "settings.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace robikzinputtest {
+
+static const int32_t AXIS_VALUE_COUNT = SDL_JOYSTICK_AXIS_MAX - SDL_JOYSTICK_AXIS_MIN + 1;
+/// Largest magnitude of a stick in the raw units, in a corner.
+static const int32_t STICK_MAGNITUDE_MAX = static_cast<int32_t>(
+	std::ceil(std::sqrt(2.0) * -static_cast<double>(SDL_JOYSTICK_AXIS_MIN))
+);
+
+static float normalize_axis_value(int32_t value) {
+	return std::clamp(
+		static_cast<float>(value) / static_cast<float>(SDL_JOYSTICK_AXIS_MAX),
+		-1.0f, 1.0f
+	);
+}
+
+AxisResponseCurve AxisResponseCurve::from_settings(const Settings &settings) {
+	AxisResponseCurve curve;
+	curve.deadzone = settings.joystick_deadzone;
+	curve.outer_deadzone = settings.joystick_outer_deadzone;
+	curve.anti_deadzone = settings.joystick_anti_deadzone;
+	curve.exponent = settings.joystick_response_exponent;
+	curve.radial = settings.joystick_radial_deadzone;
+	return curve;
+}
+
+float AxisResponseCurve::apply(float magnitude) const {
+	const float inner = std::clamp(
+		static_cast<float>(deadzone) / SDL_JOYSTICK_AXIS_MAX, 0.0f, 1.0f
+	);
+	const float outer = std::clamp(
+		1.0f - static_cast<float>(outer_deadzone) / SDL_JOYSTICK_AXIS_MAX, inner, 1.0f
+	);
+	if (magnitude <= 0.0f || magnitude < inner) {
+		return 0.0f;
+	} else if (magnitude >= outer) {
+		return 1.0f;
+	}
+	const float linear = (magnitude - inner) / (outer - inner);
+	const float curved = std::pow(linear, std::max(0.01f, exponent));
+	const float anti = std::clamp(anti_deadzone, 0.0f, 1.0f);
+	return anti + (1.0f - anti) * curved;
+}
+
+AxisResponse::AxisResponse()
+	: m_axis_table(AXIS_VALUE_COUNT, 0.0f),
+	m_radial_scale_table(STICK_MAGNITUDE_MAX + 1, 0.0f) {
+	set_curve(m_curve);
+}
+
+void AxisResponse::set_curve(const AxisResponseCurve &curve) {
+	if (m_built && curve == m_curve) {
+		return;
+	}
+	m_curve = curve;
+	m_built = true;
+	for (int32_t index = 0; index < AXIS_VALUE_COUNT; ++index) {
+		const float value = normalize_axis_value(index + SDL_JOYSTICK_AXIS_MIN);
+		if (curve.radial) {
+			// The curve gets applied on the stick's magnitude instead.
+			m_axis_table[index] = value;
+		} else {
+			m_axis_table[index] = std::copysign(curve.apply(std::abs(value)), value);
+		}
+	}
+	for (int32_t magnitude = 1; magnitude <= STICK_MAGNITUDE_MAX; ++magnitude) {
+		const float input = static_cast<float>(magnitude) / SDL_JOYSTICK_AXIS_MAX;
+		m_radial_scale_table[magnitude] = curve.apply(std::min(1.0f, input)) / input;
+	}
+	m_radial_scale_table[0] = 0.0f;
+}
+
+SDL_FPoint AxisResponse::stick(int16_t x, int16_t y) const {
+	if (!m_curve.radial) {
+		return { axis(x), axis(y) };
+	}
+	const float fx = static_cast<float>(x);
+	const float fy = static_cast<float>(y);
+	const int32_t magnitude = std::min(
+		STICK_MAGNITUDE_MAX,
+		static_cast<int32_t>(std::lround(std::sqrt(fx * fx + fy * fy)))
+	);
+	const float scale = m_radial_scale_table[magnitude] / SDL_JOYSTICK_AXIS_MAX;
+	return {
+		std::clamp(fx * scale, -1.0f, 1.0f),
+		std::clamp(fy * scale, -1.0f, 1.0f),
+	};
+}
+
+} // namespace robikzinputtest
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace robikzinputtest {
+
+struct Settings;
+
+/**
+ * Shape of the response of an analog axis.
+ *
+ * Zones are in raw axis units (0 - SDL_JOYSTICK_AXIS_MAX).
+ */
+struct AxisResponseCurve {
+	/// Values below are ignored.
+	int deadzone = 0;
+	/// Values this close to the maximum give the full output.
+	int outer_deadzone = 0;
+	/// Lowest output past the deadzone, 0.0 - 1.0.
+	float anti_deadzone = 0.0f;
+	/// Power of the curve between the zones; 1.0 is linear.
+	float exponent = 1.0f;
+	/// Apply the curve to the magnitude of a stick instead of each axis.
+	bool radial = false;
+
+	static AxisResponseCurve from_settings(const Settings &settings);
+
+	/// Output magnitude (0.0 - 1.0) for an input magnitude (0.0 - 1.0).
+	float apply(float magnitude) const;
+
+	bool operator==(const AxisResponseCurve &other) const {
+		return deadzone == other.deadzone
+			&& outer_deadzone == other.outer_deadzone
+			&& anti_deadzone == other.anti_deadzone
+			&& exponent == other.exponent
+			&& radial == other.radial;
+	}
+
+	bool operator!=(const AxisResponseCurve &other) const {
+		return !(*this == other);
+	}
+};
+
+/**
+ * Response curve precomputed for every raw axis value.
+ *
+ * Mapping an axis value costs a single table lookup. A radial curve
+ * maps a stick with one square root and a lookup.
+ */
+class AxisResponse {
+public:
+	AxisResponse();
+
+	/// Precompute the tables; does nothing if the curve didn't change.
+	void set_curve(const AxisResponseCurve &curve);
+	const AxisResponseCurve &curve() const { return m_curve; }
+
+	/// Response of a lone axis, -1.0 - 1.0.
+	float axis(int16_t value) const {
+		return m_axis_table[static_cast<int32_t>(value) - SDL_JOYSTICK_AXIS_MIN];
+	}
+
+	/// Response of a stick made of a pair of axes; each coordinate is -1.0 - 1.0.
+	SDL_FPoint stick(int16_t x, int16_t y) const;
+
+private:
+	AxisResponseCurve m_curve;
+	bool m_built = false;
+	/// Output per each raw value, indexed from SDL_JOYSTICK_AXIS_MIN.
+	std::vector<float> m_axis_table;
+	/// Output magnitude divided by input magnitude, indexed by the raw magnitude.
+	std::vector<float> m_radial_scale_table;
+};
+
+} // namespace robikzinputtest
@@ -0,0 +1,71 @@
+/**
+ * @file
+ * Throughput of the properties file parsing and writing.
+ *
+ * Built with the ROBIKZINPUTTEST_BENCHMARK CMake option. Runs each
+ * stage over a settings file many times and prints its rate:
+ * `benchmark_properties [iterations]`.
+ */
+#include "properties_file.hpp"
+#include "settings.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace robikzinputtest;
+
+static const int DEFAULT_ITERATIONS = 20000;
+
+/// Stops the optimizer from dropping the measured work.
+static volatile size_t g_sink = 0;
+
+template <typename Stage>
+static void measure(const char *name, int iterations, size_t bytes, Stage stage) {
+	using Clock = std::chrono::steady_clock;
+	const Clock::time_point start = Clock::now();
+	for (int i = 0; i < iterations; ++i) {
+		g_sink = g_sink + stage();
+	}
+	const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+	const double total_bytes = static_cast<double>(bytes) * iterations;
+	std::cout << std::left << std::setw(20) << name << std::right
+		<< std::fixed << std::setprecision(1)
+		<< std::setw(10) << total_bytes / seconds / 1e6 << " MB/s"
+		<< std::setprecision(3)
+		<< std::setw(10) << seconds * 1e6 / iterations << " us/file"
+		<< std::endl;
+}
+
+int main(int argc, char **argv) {
+	const int iterations = argc > 1 ? std::max(1, std::atoi(argv[1])) : DEFAULT_ITERATIONS;
+
+	// The settings file as the program writes it.
+	const std::vector<Property> properties = Settings().export_properties();
+	const std::string text = write_properties(properties);
+	std::cout << "Properties benchmark: " << properties.size() << " properties, "
+		<< text.size() << " bytes, " << iterations << " iterations" << std::endl;
+
+	measure("parse_properties", iterations, text.size(), [&text]() {
+		return parse_properties(text).size();
+	});
+	measure("read_properties", iterations, text.size(), [&text]() {
+		return read_properties(text).size();
+	});
+	measure("import_properties", iterations, text.size(), [&text]() {
+		Settings settings;
+		settings.import_properties(parse_properties(text));
+		return static_cast<size_t>(settings.target_fps);
+	});
+	measure("export_properties", iterations, text.size(), []() {
+		return Settings().export_properties().size();
+	});
+	measure("write_properties", iterations, text.size(), [&properties]() {
+		return write_properties(properties).size();
+	});
+	return 0;
+}
@@ -6,6 +6,7 @@
 #include <iomanip>
 #include <sstream>
 #include <string>
+#include <string_view>
 
 namespace robikzinputtest {
 
@@ -107,7 +108,7 @@ struct Color {
 	 * only contain either 6 or 8 hexadecimal digits. The digits are
 	 * case-insensitive. If 'AA' part is not specified, assume 1.0.
 	 */
-	static Color from_hex(const std::string &hexcolor, bool *ok = nullptr) {
+	static Color from_hex(std::string_view hexcolor, bool *ok = nullptr) {
 		auto is_hex = [](char c) {
 			return std::isxdigit(static_cast<unsigned char>(c));
 		};
@@ -0,0 +1,132 @@
+#include "command_line.hpp"
+
+#include "settings_profiles.hpp"
+
+#include <charconv>
+#include <iostream>
+#include <sstream>
+
+namespace robikzinputtest {
+
+std::pair<bool, CommandLineOptions> parse_command_line(int argc, char *argv[]) {
+	CommandLineOptions options;
+
+	// Options that take a value store it into the mapped string.
+	auto value_option = [&options](const std::string &arg) -> std::string * {
+		if (arg == "--record")
+			return &options.record_path;
+		if (arg == "--replay")
+			return &options.replay_path;
+		if (arg == "--report")
+			return &options.report_path;
+		if (arg == "--keyboard-report")
+			return &options.keyboard_report_path;
+		if (arg == "--axis-report")
+			return &options.axis_report_path;
+		if (arg == "--frame-report")
+			return &options.frame_report_path;
+		if (arg == "--profile")
+			return &options.profile;
+		if (arg == "--capture")
+			return &options.capture_path;
+		return nullptr;
+	};
+
+	for (int i = 1; i < argc; ++i) {
+		const std::string arg = argv[i];
+		if (arg == "-h" || arg == "--help") {
+			options.show_help = true;
+		} else if (arg == "--self-test") {
+			options.self_test = true;
+		} else if (arg == "--benchmark-renderers") {
+			options.benchmark_renderers = true;
+		} else if (arg == "--capture-every") {
+			if (i + 1 >= argc) {
+				std::cerr << "Missing value for option: " << arg << std::endl;
+				return { false, options };
+			}
+			const std::string value = argv[++i];
+			const auto result = std::from_chars(value.data(), value.data() + value.size(), options.capture_every);
+			if (result.ec != std::errc() || result.ptr != value.data() + value.size() || options.capture_every < 1) {
+				std::cerr << "Invalid value for option " << arg << ": " << value << std::endl;
+				return { false, options };
+			}
+		} else if (arg == "--measurement-mode") {
+			options.measurement_mode = true;
+		} else if (arg == "--virtual-sensors") {
+			options.virtual_sensors = true;
+		} else if (std::string *value = value_option(arg)) {
+			if (i + 1 >= argc) {
+				std::cerr << "Missing value for option: " << arg << std::endl;
+				return { false, options };
+			}
+			*value = argv[++i];
+		} else {
+			std::cerr << "Unknown option: " << arg << std::endl;
+			return { false, options };
+		}
+	}
+
+	if (!options.record_path.empty() && !options.replay_path.empty()) {
+		std::cerr << "Options --record and --replay are mutually exclusive" << std::endl;
+		return { false, options };
+	}
+	if (options.self_test && !options.replay_path.empty()) {
+		std::cerr << "Options --self-test and --replay are mutually exclusive" << std::endl;
+		return { false, options };
+	}
+	if (options.benchmark_renderers && (options.self_test || !options.replay_path.empty())) {
+		std::cerr << "Option --benchmark-renderers excludes --self-test and --replay" << std::endl;
+		return { false, options };
+	}
+	if (options.virtual_sensors && !options.replay_path.empty()) {
+		std::cerr << "Options --virtual-sensors and --replay are mutually exclusive" << std::endl;
+		return { false, options };
+	}
+	if (!options.profile.empty() && !SettingsProfiles::is_valid_name(options.profile)) {
+		std::cerr << "Invalid profile name, use letters, digits, '-' and '_': " << options.profile << std::endl;
+		return { false, options };
+	}
+	return { true, options };
+}
+
+std::string command_line_usage(const std::string &program) {
+	std::ostringstream ss;
+	ss << "Usage: " << program << " [options]" << std::endl
+		<< std::endl
+		<< "Options:" << std::endl
+		<< "  -h, --help         Show this help and exit." << std::endl
+		<< "  --record FILE      Record the input session into FILE." << std::endl
+		<< "  --replay FILE      Replay the input session from FILE and quit" << std::endl
+		<< "                     when it ends. Live input is ignored." << std::endl
+		<< "  --report FILE      Write per-frame gizmo trajectories and the" << std::endl
+		<< "                     input-to-present latency into FILE." << std::endl
+		<< "  --keyboard-report FILE" << std::endl
+		<< "                     Write per-key chatter and debounce statistics" << std::endl
+		<< "                     into FILE on exit." << std::endl
+		<< "  --axis-report FILE Write joystick axis noise, drift and resolution" << std::endl
+		<< "                     statistics into FILE on exit." << std::endl
+		<< "  --frame-report FILE" << std::endl
+		<< "                     Write the mean cost of each frame phase and" << std::endl
+		<< "                     the GUI frame cache savings into FILE on exit." << std::endl
+		<< "  --self-test        Measure the input-to-pixel latency with injected" << std::endl
+		<< "                     joystick presses, print the results and quit." << std::endl
+		<< "  --benchmark-renderers" << std::endl
+		<< "                     Run a scripted scene on every render driver" << std::endl
+		<< "                     without vsync, print the frame and present" << std::endl
+		<< "                     times of each and quit." << std::endl
+		<< "  --measurement-mode Start with the GUI turned off, so that it adds" << std::endl
+		<< "                     nothing to the frame times; F7 toggles it." << std::endl
+		<< "  --virtual-sensors  Attach a virtual gamepad that streams gyroscope" << std::endl
+		<< "                     and accelerometer samples." << std::endl
+		<< "  --profile NAME     Start in the NAME settings profile, made from" << std::endl
+		<< "                     the default settings if it doesn't exist." << std::endl
+		<< "                     F6 switches to the next profile." << std::endl
+		<< "  --capture PATH     Write the rendered frames into PATH: a YUV4MPEG2" << std::endl
+		<< "                     video if it ends with .y4m, otherwise a directory" << std::endl
+		<< "                     of numbered BMP images." << std::endl
+		<< "  --capture-every N  Capture only every Nth frame." << std::endl;
+	return ss.str();
+}
+
+} // namespace robikzinputtest
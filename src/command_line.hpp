@@ -0,0 +1,51 @@
+#pragma once
+
+#include <string>
+#include <utility>
+
+namespace robikzinputtest {
+
+struct CommandLineOptions {
+	bool show_help = false;
+	/// Record the input session into this file.
+	std::string record_path;
+	/// Replay the input session from this file instead of live input.
+	std::string replay_path;
+	/// Write the per-frame arena report into this file.
+	std::string report_path;
+	/// Write the keyboard analysis into this file on exit.
+	std::string keyboard_report_path;
+	/// Write the joystick axis noise analysis into this file on exit.
+	std::string axis_report_path;
+	/// Write the frame phase summary into this file on exit.
+	std::string frame_report_path;
+	/// Measure the input-to-pixel latency with injected input and quit.
+	bool self_test = false;
+	/// Run a scripted scene on every render driver, print the comparison and quit.
+	bool benchmark_renderers = false;
+	/// Attach a virtual gamepad that streams gyro and accelerometer samples.
+	bool virtual_sensors = false;
+	/// Start with the GUI off, so that it doesn't weigh on the measurements.
+	bool measurement_mode = false;
+	/// Start in this settings profile; created if there's none.
+	std::string profile;
+	/// Write the rendered frames into this video file or directory.
+	std::string capture_path;
+	/// Capture only every Nth frame.
+	int capture_every = 1;
+};
+
+/**
+ * Parse the program arguments.
+ *
+ * On failure, the returned bool is false and the reason is printed
+ * to stderr.
+ */
+std::pair<bool, CommandLineOptions> parse_command_line(int argc, char *argv[]);
+
+/**
+ * Text listing all available command line options.
+ */
+std::string command_line_usage(const std::string &program);
+
+} // namespace robikzinputtest
@@ -1,7 +1,9 @@
 #pragma once
 
 #include "controller_handler.hpp"
+#include "latency_tracker.hpp"
 #include <SDL3/SDL.h>
+#include <array>
 #include <memory>
 #include <string>
 
@@ -16,13 +18,15 @@ struct ControllerId {
 	};
 
 	Type type = TYPE_NONE;
+	/// Stable across reconnects of the same device.
 	std::string identifier;
+	/// Device instance the controller is bound to; 0 when it's unplugged.
 	uint32_t index;
 
+	/// The same controller, even if it got bound to a different instance.
 	bool operator==(const ControllerId &other) const {
 		return (type == other.type)
-			&& (identifier == other.identifier)
-			&& (index == other.index);
+			&& (identifier == other.identifier);
 	}
 
 	bool operator!=(const ControllerId &other) const {
@@ -36,14 +40,46 @@ enum class ButtonState {
 	RELEASED,
 };
 
+/**
+ * State of a single physical button of the controller.
+ */
+struct ButtonChannel {
+	ButtonState state = ButtonState::CLEAR;
+	/// Event timestamp of the last press, in SDL_GetTicksNS() nanoseconds.
+	Uint64 pressed_at_ns = 0;
+};
+
 struct ControllerState {
+	/**
+	 * Number of the button channels.
+	 *
+	 * Joysticks map their buttons to the channels by their index, and
+	 * the throttles to the last two channels. Buttons past them aren't
+	 * tracked individually; they only press the primary button.
+	 */
+	static constexpr int BUTTON_CHANNELS = 32;
+	static constexpr int LEFT_THROTTLE_CHANNEL = BUTTON_CHANNELS - 2;
+	static constexpr int RIGHT_THROTTLE_CHANNEL = BUTTON_CHANNELS - 1;
+
 	SDL_FPoint direction_vec2 = { 0.0f, 0.0f };
+	/**
+	 * Movement in pixels accumulated since the last arena update,
+	 * applied directly and not scaled by the gizmo speed.
+	 */
+	SDL_FPoint motion_vec2 = { 0.0f, 0.0f };
+	/// Any of the button channels, or of the untracked buttons.
 	ButtonState button_primary = ButtonState::CLEAR;
+	std::array<ButtonChannel, BUTTON_CHANNELS> buttons {};
+
+	bool is_button_down(int channel) const {
+		return buttons[channel].state == ButtonState::PRESSED;
+	}
 };
 
 class Controller {
 public:
-	const ControllerId id;
+	/// The index gets rebound when a pooled joystick controller is reused.
+	ControllerId id;
 	ControllerState state;
 
 	Controller(const ControllerId &controller_id)
@@ -59,10 +95,66 @@ public:
 	void set_handler(std::shared_ptr<ControllerHandler> handler) {
 		m_handler = handler;
 		this->state = ControllerState();
+		m_buttons_down = 0;
+		m_untracked_buttons_down = 0;
+	}
+
+	/**
+	 * Press or release the button channel. The primary button follows
+	 * the channels: it's pressed while any of them is, unless the channel
+	 * is pressed with drives_primary unset. A channel must be pressed and
+	 * released with the same drives_primary.
+	 */
+	void set_button(int channel, bool down, Uint64 timestamp_ns, bool drives_primary = true) {
+		if (channel < 0 || channel >= ControllerState::BUTTON_CHANNELS) {
+			return;
+		}
+		ButtonChannel &button = state.buttons[channel];
+		const int primary_count = drives_primary ? 1 : 0;
+		if (down && button.state != ButtonState::PRESSED) {
+			button.state = ButtonState::PRESSED;
+			button.pressed_at_ns = timestamp_ns;
+			m_button_latency[channel].add_input(timestamp_ns);
+			m_buttons_down += primary_count;
+		} else if (!down && button.state == ButtonState::PRESSED) {
+			button.state = ButtonState::RELEASED;
+			m_buttons_down -= primary_count;
+		}
+		update_button_primary();
+	}
+
+	/// Number of the held buttons that have no channel of their own.
+	void set_untracked_buttons_down(int count) {
+		m_untracked_buttons_down = count;
+		update_button_primary();
+	}
+
+	/// The frame that shows the pressed buttons got presented.
+	void frame_presented(Uint64 present_ns) {
+		for (LatencyTracker &latency : m_button_latency) {
+			latency.presented(present_ns);
+		}
+	}
+
+	/// Latency from the button's press to the present of the frame that shows it.
+	const LatencyTracker &button_latency(int channel) const {
+		return m_button_latency[channel];
 	}
 
 private:
 	std::shared_ptr<ControllerHandler> m_handler;
+	/// Held channels that drive the primary button.
+	int m_buttons_down = 0;
+	int m_untracked_buttons_down = 0;
+	std::array<LatencyTracker, ControllerState::BUTTON_CHANNELS> m_button_latency {};
+
+	void update_button_primary() {
+		if (m_buttons_down + m_untracked_buttons_down > 0) {
+			state.button_primary = ButtonState::PRESSED;
+		} else if (state.button_primary == ButtonState::PRESSED) {
+			state.button_primary = ButtonState::RELEASED;
+		}
+	}
 };
 
 } // namespace robikzinputtest
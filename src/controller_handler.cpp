@@ -1,12 +1,18 @@
 #include "controller_handler.hpp"
 
 #include "app.hpp"
+#include "axis_response.hpp"
 #include "controller.hpp"
+#include "gamepad_mapping.hpp"
 #include "sdl_math.hpp"
+#include "sensor_capture.hpp"
 #include "settings.hpp"
 
 #include <SDL3/SDL.h>
 
+#include <algorithm>
+#include <array>
+#include <bitset>
 #include <cstdlib>
 
 namespace robikzinputtest {
@@ -27,56 +33,61 @@ static const int32_t JOYSTICK_AXIS_MIN32 = SDL_JOYSTICK_AXIS_MIN;
 
 static const int16_t JOYSTICK_AXIS_THRESHOLD = SDL_JOYSTICK_AXIS_MAX / 10;
 
-static bool is_joystick_horizontal_axis(int32_t axis) {
-	return axis == JOYSTICK_GAMEPAD_LEFT_THUMBSTICK_HAXIS
-		|| axis == JOYSTICK_GAMEPAD_RIGHT_THUMBSTICK_HAXIS;
+static bool is_joystick_throttle_axis(int32_t axis) {
+	return axis == JOYSTICK_GAMEPAD_LEFT_THROTTLE_AXIS
+		|| axis == JOYSTICK_GAMEPAD_RIGHT_THROTTLE_AXIS;
 }
 
-static bool is_joystick_vertical_axis(int32_t axis) {
-	return axis == JOYSTICK_GAMEPAD_LEFT_THUMBSTICK_VAXIS
-		|| axis == JOYSTICK_GAMEPAD_RIGHT_THUMBSTICK_VAXIS;
+/**
+ * Clamp the movement direction to a unit vector.
+ *
+ * Magnitudes lower than a unit are allowed.
+ */
+static SDL_FPoint clamp_movement_direction(SDL_FPoint direction) {
+	if (sdl::magvec_fpoint(direction) > 1.0f) {
+		return sdl::normveci_fpoint(direction);
+	}
+	return direction;
 }
 
-static bool is_joystick_throttle_axis(int32_t axis) {
-	return axis == JOYSTICK_GAMEPAD_LEFT_THROTTLE_AXIS
-		|| axis == JOYSTICK_GAMEPAD_RIGHT_THROTTLE_AXIS;
+/**
+ * Read the joystick's stick made of the given pair of axes.
+ *
+ * Axes that the joystick doesn't have read as 0.
+ */
+static SDL_FPoint get_joystick_stick(
+	SDL_Joystick *joystick,
+	int32_t n_axes,
+	int32_t haxis,
+	int32_t vaxis,
+	const AxisResponse &response
+) {
+	const int16_t x = haxis < n_axes ? SDL_GetJoystickAxis(joystick, haxis) : 0;
+	const int16_t y = vaxis < n_axes ? SDL_GetJoystickAxis(joystick, vaxis) : 0;
+	return response.stick(x, y);
 }
 
 /**
  * Get movement direction as indicated by joystick's axes (thumbsticks).
  *
- * Deadzone is taken into account. An axis with an absolute value below the
- * deadzone is ignored. Axis value gets rescaled linearly in accordance to
- * the deadzone.
+ * The thumbsticks go through the axis response curve.
  *
  * The movement direction is not normalized (it may exceed a unit vector).
  */
-static SDL_FPoint get_joystick_axis_direction(SDL_Joystick *joystick, int32_t deadzone) {
+static SDL_FPoint get_joystick_axis_direction(SDL_Joystick *joystick, const AxisResponse &response) {
 	SDL_FPoint total_direction = { 0, 0 };
 	SDL_LockJoysticks();
 	const int32_t n_axes = SDL_GetNumJoystickAxes(joystick);
-	for (int32_t n_axis = 0; n_axis < n_axes; ++n_axis) {
-		const int32_t axis = SDL_GetJoystickAxis(joystick, n_axis);
-		if (axis != 0 && std::abs(axis) >= deadzone) {
-			float axis_magnitude = 0.0f;
-			if (axis > 0 && deadzone < JOYSTICK_AXIS_MAX32) {
-				axis_magnitude =
-					static_cast<float>(axis - deadzone)
-					/ static_cast<float>(JOYSTICK_AXIS_MAX32 - deadzone);
-			} else if (axis < 0 && -deadzone > JOYSTICK_AXIS_MIN32) {
-				axis_magnitude =
-					static_cast<float>(axis + deadzone)
-					/ static_cast<float>(JOYSTICK_AXIS_MIN32 + deadzone);
-				axis_magnitude *= -1;
-			}
-			if (is_joystick_horizontal_axis(n_axis)) {
-				total_direction.x += axis_magnitude;
-			}
-			if (is_joystick_vertical_axis(n_axis)) {
-				total_direction.y += axis_magnitude;
-			}
-		}
-	}
+	sdl::addi_fpoint(total_direction, get_joystick_stick(
+		joystick, n_axes,
+		JOYSTICK_GAMEPAD_LEFT_THUMBSTICK_HAXIS, JOYSTICK_GAMEPAD_LEFT_THUMBSTICK_VAXIS,
+		response
+	));
+	sdl::addi_fpoint(total_direction, get_joystick_stick(
+		joystick, n_axes,
+		JOYSTICK_GAMEPAD_RIGHT_THUMBSTICK_HAXIS, JOYSTICK_GAMEPAD_RIGHT_THUMBSTICK_VAXIS,
+		response
+	));
 	SDL_UnlockJoysticks();
 	return total_direction;
 }
@@ -106,20 +117,24 @@ static SDL_FPoint get_joystick_dpad_direction(SDL_Joystick *joystick) {
 /**
  * Sum up all joystick movements buttons into a movement vector.
  */
-static SDL_FPoint get_joystick_complete_normalized_movement_direction(SDL_Joystick *joystick, int32_t deadzone) {
+static SDL_FPoint get_joystick_complete_normalized_movement_direction(SDL_Joystick *joystick, const AxisResponse &response) {
 	SDL_FPoint total_direction = { 0, 0 };
-	sdl::addi_fpoint(total_direction, get_joystick_axis_direction(joystick, deadzone));
+	sdl::addi_fpoint(total_direction, get_joystick_axis_direction(joystick, response));
 	sdl::addi_fpoint(total_direction, get_joystick_dpad_direction(joystick));
-	if (sdl::magvec_fpoint(total_direction) > 1.0f) {
-		// If overall magnitude is higher than a unit, clamp it.
-		return sdl::normveci_fpoint(total_direction);
-	} else {
-		// Magnitudes lower than a unit are allowed.
-		return total_direction;
-	}
+	return clamp_movement_direction(total_direction);
 }
 
 #if 0
+static bool is_joystick_horizontal_axis(int32_t axis) {
+	return axis == JOYSTICK_GAMEPAD_LEFT_THUMBSTICK_HAXIS
+		|| axis == JOYSTICK_GAMEPAD_RIGHT_THUMBSTICK_HAXIS;
+}
+
+static bool is_joystick_vertical_axis(int32_t axis) {
+	return axis == JOYSTICK_GAMEPAD_LEFT_THUMBSTICK_VAXIS
+		|| axis == JOYSTICK_GAMEPAD_RIGHT_THUMBSTICK_VAXIS;
+}
+
 static int32_t sum_joystick_thumbsticks_for_axis(SDL_Joystick *joystick, int32_t axis, int32_t deadzone) {
 	SDL_LockJoysticks();
 	const int32_t n_axes = SDL_GetNumJoystickAxes(joystick);
@@ -166,17 +181,19 @@ bool JoystickControllerHandler::handle_event(
 
 		const uint32_t axis = event.jaxis.axis;
 		if (is_joystick_throttle_axis(axis)) {
-			if (event.jaxis.value >= SDL_JOYSTICK_AXIS_MIN + JOYSTICK_AXIS_THRESHOLD) {
-				state.button_primary = ButtonState::PRESSED;
-			} else if (state.button_primary == ButtonState::PRESSED) {
-				state.button_primary = ButtonState::RELEASED;
-			}
+			controller.set_button(
+				axis == JOYSTICK_GAMEPAD_LEFT_THROTTLE_AXIS
+					? ControllerState::LEFT_THROTTLE_CHANNEL
+					: ControllerState::RIGHT_THROTTLE_CHANNEL,
+				event.jaxis.value >= SDL_JOYSTICK_AXIS_MIN + JOYSTICK_AXIS_THRESHOLD,
+				event.jaxis.timestamp
+			);
 		} else {
 			SDL_Joystick *joystick = SDL_GetJoystickFromID(event.jaxis.which);
 			if (joystick != nullptr) {
 				state.direction_vec2 = get_joystick_complete_normalized_movement_direction(
 					joystick,
-					app.settings().joystick_deadzone
+					app.axis_response()
 				);
 			}
 		}
@@ -188,7 +205,7 @@ bool JoystickControllerHandler::handle_event(
 		if (joystick != nullptr) {
 			state.direction_vec2 = get_joystick_complete_normalized_movement_direction(
 				joystick,
-				app.settings().joystick_deadzone
+				app.axis_response()
 			);
 		}
 	} else if (
@@ -198,50 +215,372 @@ bool JoystickControllerHandler::handle_event(
 		if (event.jbutton.which != controller.id.index)
 			return false;
 
-		const bool is_pressed = event.type == SDL_EVENT_JOYSTICK_BUTTON_DOWN;
-		state.button_primary = is_pressed ? ButtonState::PRESSED : ButtonState::RELEASED;
+		// The last channels belong to the throttles.
+		if (event.jbutton.button < ControllerState::LEFT_THROTTLE_CHANNEL) {
+			controller.set_button(event.jbutton.button, event.jbutton.down, event.jbutton.timestamp);
+		} else {
+			m_untracked_buttons.set(event.jbutton.button, event.jbutton.down);
+			controller.set_untracked_buttons_down(static_cast<int>(m_untracked_buttons.count()));
+		}
+	}
+	return false;
+}
+
+/*
+  GamepadControllerHandler
+*/
+
+using GamepadUPtr = std::unique_ptr<SDL_Gamepad, decltype(&SDL_CloseGamepad)>;
+
+/// Gyro samples further apart are a restart, not a rotation.
+static const Uint64 MAX_GYRO_INTERVAL_NS = 100'000'000;
+
+struct GamepadControllerHandler::D {
+	/**
+	 * Every raw control that can drive a digital GamepadControl has
+	 * its own bit, so a control stays down while any of its sources
+	 * holds it.
+	 */
+	static constexpr int SOURCE_BUTTONS = 0;
+	static constexpr int SOURCE_HATS = SOURCE_BUTTONS + GamepadMapping::MAX_BUTTONS;
+	static constexpr int SOURCE_AXES = SOURCE_HATS + GamepadMapping::MAX_HATS * GamepadMapping::HAT_DIRECTIONS;
+	static constexpr int SOURCE_TRIGGERS = SOURCE_AXES + GamepadMapping::MAX_AXES * GamepadMapping::MAX_AXIS_BINDINGS;
+	static constexpr int SOURCE_COUNT = SOURCE_TRIGGERS + 2;
+	static constexpr int DIGITAL_CONTROL_COUNT =
+		static_cast<int>(GamepadControl::ACTION) + 1 - GAMEPAD_ANALOG_CONTROL_COUNT;
+	/// Most action sources one event changes: the directions of a hat.
+	static constexpr int MAX_ACTION_CHANGES =
+		std::max(GamepadMapping::MAX_AXIS_BINDINGS, GamepadMapping::HAT_DIRECTIONS);
+
+	SDL_JoystickID joystick_id;
+	GamepadUPtr gamepad;
+	GamepadMapping mapping;
+
+	std::array<int16_t, GAMEPAD_ANALOG_CONTROL_COUNT> analog {};
+	std::array<std::bitset<SOURCE_COUNT>, DIGITAL_CONTROL_COUNT> digital {};
+	/// Held action sources without a button channel.
+	int untracked_action_down = 0;
+	/// The button channels whose action source the event changed.
+	std::array<int, MAX_ACTION_CHANGES> changed_channels {};
+	int changed_channel_count = 0;
+	bool untracked_action_changed = false;
+	/// Timestamp of the previous gyro sample, to integrate the rotation.
+	Uint64 last_gyro_ns = 0;
+
+	D(SDL_JoystickID joystick_id)
+		: joystick_id(joystick_id),
+		gamepad(SDL_OpenGamepad(joystick_id), &SDL_CloseGamepad) {
+		if (gamepad) {
+			mapping = GamepadMapping::from_gamepad(gamepad.get());
+			// The sensors stay silent until enabled.
+			for (SDL_SensorType sensor : { SDL_SENSOR_GYRO, SDL_SENSOR_ACCEL }) {
+				if (SDL_GamepadHasSensor(gamepad.get(), sensor)) {
+					SDL_SetGamepadSensorEnabled(gamepad.get(), sensor, true);
+				}
+			}
+		}
+	}
+
+	/**
+	 * Turn the gyro's angular velocity into gizmo motion: yaw moves
+	 * the gizmo sideways, pitch up and down, like aiming with the pad.
+	 */
+	SDL_FPoint gyro_motion(const SDL_GamepadSensorEvent &event, float sensitivity) {
+		// Prefer the device's clock, it doesn't suffer the delivery jitter.
+		const Uint64 timestamp_ns = event.sensor_timestamp != 0 ? event.sensor_timestamp : event.timestamp;
+		const Uint64 previous_ns = last_gyro_ns;
+		last_gyro_ns = timestamp_ns;
+		if (previous_ns == 0 || timestamp_ns <= previous_ns || timestamp_ns - previous_ns > MAX_GYRO_INTERVAL_NS) {
+			return { 0.0f, 0.0f };
+		}
+		const float dt = static_cast<float>(timestamp_ns - previous_ns) / 1e9f;
+		// SDL's rotations are counterclockwise-positive: X is pitch, Y is yaw.
+		return {
+			-event.data[1] * dt * sensitivity,
+			-event.data[0] * dt * sensitivity,
+		};
+	}
+
+	int16_t analog_value(GamepadControl control) const {
+		return analog[static_cast<int>(control)];
+	}
+
+	bool is_down(GamepadControl control) const {
+		return digital[static_cast<int>(control) - GAMEPAD_ANALOG_CONTROL_COUNT].any();
+	}
+
+	void set_analog(GamepadControl control, int32_t value) {
+		analog[static_cast<int>(control)] = static_cast<int16_t>(
+			SDL_clamp(value, JOYSTICK_AXIS_MIN32, JOYSTICK_AXIS_MAX32)
+		);
+		// Triggers act as the action button.
+		if (control == GamepadControl::LEFT_TRIGGER || control == GamepadControl::RIGHT_TRIGGER) {
+			const int source = SOURCE_TRIGGERS + (control == GamepadControl::LEFT_TRIGGER ? 0 : 1);
+			set_digital(GamepadControl::ACTION, source, value >= JOYSTICK_AXIS_THRESHOLD);
+		}
+	}
+
+	void set_digital(GamepadControl control, int source, bool down) {
+		std::bitset<SOURCE_COUNT> &sources = digital[static_cast<int>(control) - GAMEPAD_ANALOG_CONTROL_COUNT];
+		if (control == GamepadControl::ACTION && sources.test(source) != down) {
+			const int channel = action_channel(source);
+			if (channel < 0) {
+				untracked_action_down += down ? 1 : -1;
+				untracked_action_changed = true;
+			} else if (changed_channel_count < MAX_ACTION_CHANGES) {
+				changed_channels[changed_channel_count++] = channel;
+			}
+		}
+		sources.set(source, down);
+	}
+
+	void handle_axis(int raw_axis, int32_t value) {
+		const GamepadMapping::AxisBindings &bindings = mapping.axis(raw_axis);
+		// Reset the out-of-range bindings first, so that a half-axis
+		// binding doesn't overwrite the other half that is in range.
+		for (int slot = 0; slot < GamepadMapping::MAX_AXIS_BINDINGS; ++slot) {
+			const GamepadAxisBinding &binding = bindings[slot];
+			if (binding.control != GamepadControl::NONE && !binding.in_range(value)) {
+				set_control(binding.control, SOURCE_AXES + raw_axis * GamepadMapping::MAX_AXIS_BINDINGS + slot, 0, false);
+			}
+		}
+		for (int slot = 0; slot < GamepadMapping::MAX_AXIS_BINDINGS; ++slot) {
+			const GamepadAxisBinding &binding = bindings[slot];
+			if (binding.control != GamepadControl::NONE && binding.in_range(value)) {
+				set_control(
+					binding.control,
+					SOURCE_AXES + raw_axis * GamepadMapping::MAX_AXIS_BINDINGS + slot,
+					binding.map(value),
+					binding.is_pressed(value)
+				);
+			}
+		}
+	}
+
+	void handle_button(int raw_button, bool down) {
+		const GamepadButtonBinding binding = mapping.button(raw_button);
+		set_control(
+			binding.control,
+			SOURCE_BUTTONS + raw_button,
+			down ? binding.analog_value : 0,
+			down
+		);
+	}
+
+	void handle_hat(int raw_hat, uint8_t value) {
+		const GamepadMapping::HatBindings &bindings = mapping.hat(raw_hat);
+		for (uint8_t hat_bit : { SDL_HAT_UP, SDL_HAT_RIGHT, SDL_HAT_DOWN, SDL_HAT_LEFT }) {
+			const int direction = GamepadMapping::hat_direction_index(hat_bit);
+			const bool down = (value & hat_bit) != 0;
+			set_control(
+				bindings[direction],
+				SOURCE_HATS + raw_hat * GamepadMapping::HAT_DIRECTIONS + direction,
+				down ? SDL_JOYSTICK_AXIS_MAX : 0,
+				down
+			);
+		}
+	}
+
+	void set_control(GamepadControl control, int source, int32_t analog_value, bool down) {
+		if (control == GamepadControl::NONE) {
+			return;
+		} else if (is_gamepad_analog_control(control)) {
+			set_analog(control, analog_value);
+		} else if (source >= 0 && source < SOURCE_COUNT) {
+			set_digital(control, source, down);
+		}
+	}
+
+	/**
+	 * The button channel of an action source, or -1 if it has none.
+	 * Raw buttons map to the channels by their index, the triggers to
+	 * the throttle channels; the other buttons, the hats and the axes
+	 * aren't tracked individually.
+	 */
+	static int action_channel(int source) {
+		if (source >= SOURCE_BUTTONS && source < SOURCE_BUTTONS + ControllerState::LEFT_THROTTLE_CHANNEL) {
+			return source - SOURCE_BUTTONS;
+		} else if (source == SOURCE_TRIGGERS) {
+			return ControllerState::LEFT_THROTTLE_CHANNEL;
+		} else if (source == SOURCE_TRIGGERS + 1) {
+			return ControllerState::RIGHT_THROTTLE_CHANNEL;
+		}
+		return -1;
+	}
+
+	/// Is the action button channel down.
+	bool is_action_channel_down(int channel) const {
+		const std::bitset<SOURCE_COUNT> &action = action_sources();
+		switch (channel) {
+		case ControllerState::LEFT_THROTTLE_CHANNEL:
+			return action.test(SOURCE_TRIGGERS);
+		case ControllerState::RIGHT_THROTTLE_CHANNEL:
+			return action.test(SOURCE_TRIGGERS + 1);
+		default:
+			return action.test(SOURCE_BUTTONS + channel);
+		}
+	}
+
+	const std::bitset<SOURCE_COUNT> &action_sources() const {
+		return digital[static_cast<int>(GamepadControl::ACTION) - GAMEPAD_ANALOG_CONTROL_COUNT];
+	}
+
+	SDL_FPoint movement_direction(const AxisResponse &response) const {
+		SDL_FPoint direction = response.stick(
+			analog_value(GamepadControl::LEFT_STICK_X),
+			analog_value(GamepadControl::LEFT_STICK_Y)
+		);
+		sdl::addi_fpoint(direction, response.stick(
+			analog_value(GamepadControl::RIGHT_STICK_X),
+			analog_value(GamepadControl::RIGHT_STICK_Y)
+		));
+		direction.x += is_down(GamepadControl::DPAD_LEFT) ? -1.0f : 0.0f;
+		direction.x += is_down(GamepadControl::DPAD_RIGHT) ? +1.0f : 0.0f;
+		direction.y += is_down(GamepadControl::DPAD_UP) ? -1.0f : 0.0f;
+		direction.y += is_down(GamepadControl::DPAD_DOWN) ? +1.0f : 0.0f;
+		return clamp_movement_direction(direction);
+	}
+};
+
+GamepadControllerHandler::GamepadControllerHandler(SDL_JoystickID joystick_id)
+	: d(std::make_unique<D>(joystick_id)) {
+}
+
+GamepadControllerHandler::~GamepadControllerHandler() = default;
+
+bool GamepadControllerHandler::valid() const {
+	return d->gamepad != nullptr;
+}
+
+bool GamepadControllerHandler::handle_event(
+	App &app,
+	Controller &controller,
+	const SDL_Event &event
+) {
+	switch (event.type) {
+	case SDL_EVENT_JOYSTICK_AXIS_MOTION:
+		if (event.jaxis.which != d->joystick_id)
+			return false;
+		d->handle_axis(event.jaxis.axis, event.jaxis.value);
+		break;
+	case SDL_EVENT_JOYSTICK_HAT_MOTION:
+		if (event.jhat.which != d->joystick_id)
+			return false;
+		d->handle_hat(event.jhat.hat, event.jhat.value);
+		break;
+	case SDL_EVENT_JOYSTICK_BUTTON_DOWN:
+	case SDL_EVENT_JOYSTICK_BUTTON_UP:
+		if (event.jbutton.which != d->joystick_id)
+			return false;
+		d->handle_button(event.jbutton.button, event.jbutton.down);
+		break;
+	case SDL_EVENT_GAMEPAD_SENSOR_UPDATE:
+		if (event.gsensor.which != d->joystick_id || !is_gyro_sensor(event.gsensor.sensor))
+			return false;
+		if (app.settings().gyro_steering) {
+			sdl::addi_fpoint(
+				controller.state.motion_vec2,
+				d->gyro_motion(event.gsensor, app.settings().gyro_sensitivity)
+			);
+		} else {
+			d->last_gyro_ns = 0;
+		}
+		return false;
+	default:
+		return false;
+	}
+
+	controller.state.direction_vec2 = d->movement_direction(app.axis_response());
+	// Only the channels of the sources the event changed.
+	for (int i = 0; i < d->changed_channel_count; ++i) {
+		const int channel = d->changed_channels[i];
+		controller.set_button(channel, d->is_action_channel_down(channel), event.common.timestamp);
+	}
+	d->changed_channel_count = 0;
+	if (d->untracked_action_changed) {
+		controller.set_untracked_buttons_down(d->untracked_action_down);
+		d->untracked_action_changed = false;
 	}
 	return false;
 }
 
+/*
+  MouseControllerHandler
+*/
+
+bool MouseControllerHandler::handle_event(
+	App &app,
+	Controller &controller,
+	const SDL_Event &event
+) {
+	(void) app;
+	ControllerState &state = controller.state;
+	switch (event.type) {
+	case SDL_EVENT_MOUSE_MOTION:
+		if (event.motion.which != m_mouse_id)
+			return false;
+		state.motion_vec2.x += event.motion.xrel;
+		state.motion_vec2.y += event.motion.yrel;
+		return true;
+	case SDL_EVENT_MOUSE_BUTTON_DOWN:
+	case SDL_EVENT_MOUSE_BUTTON_UP:
+		if (event.button.which != m_mouse_id)
+			return false;
+		// SDL_BUTTON_LEFT is 1. Every button has its channel, but only
+		// the left one is the action.
+		controller.set_button(
+			event.button.button - 1,
+			event.button.down,
+			event.button.timestamp,
+			event.button.button == SDL_BUTTON_LEFT
+		);
+		return true;
+	default:
+		return false;
+	}
+}
+
 /*
   KeyboardControllerHandler
 */
 
+static KeySet make_key_set(std::initializer_list<SDL_Scancode> scancodes) {
+	KeySet keys;
+	for (SDL_Scancode scancode : scancodes) {
+		keys.set(scancode);
+	}
+	return keys;
+}
+
+static const KeySet KEYS_UP = make_key_set({ SDL_SCANCODE_UP, SDL_SCANCODE_W });
+static const KeySet KEYS_DOWN = make_key_set({ SDL_SCANCODE_DOWN, SDL_SCANCODE_S });
+static const KeySet KEYS_LEFT = make_key_set({ SDL_SCANCODE_LEFT, SDL_SCANCODE_A });
+static const KeySet KEYS_RIGHT = make_key_set({ SDL_SCANCODE_RIGHT, SDL_SCANCODE_D });
+/// Each action key has its own button channel, in this order.
+static const std::array<SDL_Scancode, 2> ACTION_KEYS = { SDL_SCANCODE_SPACE, SDL_SCANCODE_RETURN };
+static const KeySet KEYS_ACTION = make_key_set({ SDL_SCANCODE_SPACE, SDL_SCANCODE_RETURN });
+static const KeySet KEYS_HANDLED = KEYS_UP | KEYS_DOWN | KEYS_LEFT | KEYS_RIGHT | KEYS_ACTION;
+
 bool KeyboardControllerHandler::handle_event(
 	App &app,
 	Controller &controller,
 	const SDL_Event &event
 ) {
+	(void) app;
+	if (!m_keyboard.handle_event(event)) {
+		return false;
+	}
 	ControllerState &state = controller.state;
-	if (event.type == SDL_EVENT_KEY_DOWN || event.type == SDL_EVENT_KEY_UP) {
-		bool is_pressed = (event.type == SDL_EVENT_KEY_DOWN);
-		switch (event.key.key) {
-		case SDLK_UP:
-		case SDLK_W:
-			state.direction_vec2.y = is_pressed ? -1.0 : 0.0;
-			return true;
-		case SDLK_DOWN:
-		case SDLK_S:
-			state.direction_vec2.y = is_pressed ? 1.0 : 0.0;
-			return true;
-		case SDLK_LEFT:
-		case SDLK_A:
-			state.direction_vec2.x = is_pressed ? -1.0 : 0.0;
-			return true;
-		case SDLK_RIGHT:
-		case SDLK_D:
-			state.direction_vec2.x = is_pressed ? 1.0 : 0.0;
-			return true;
-		case SDLK_SPACE:
-		case SDLK_RETURN:
-			state.button_primary = is_pressed ? ButtonState::PRESSED : ButtonState::RELEASED;
-			return true;
-		default:
-			break;
-		}
+	state.direction_vec2.x =
+		static_cast<float>(m_keyboard.any_down(KEYS_RIGHT))
+		- static_cast<float>(m_keyboard.any_down(KEYS_LEFT));
+	state.direction_vec2.y =
+		static_cast<float>(m_keyboard.any_down(KEYS_DOWN))
+		- static_cast<float>(m_keyboard.any_down(KEYS_UP));
+	for (int channel = 0; channel < static_cast<int>(ACTION_KEYS.size()); ++channel) {
+		controller.set_button(channel, m_keyboard.is_down(ACTION_KEYS[channel]), event.key.timestamp);
 	}
-	return false;
+	return event.key.scancode < SDL_SCANCODE_COUNT && KEYS_HANDLED.test(event.key.scancode);
 }
 
 } // namespace robikzinputtest
@@ -1,7 +1,12 @@
 #pragma once
 
+#include "keyboard_state.hpp"
+
 #include <SDL3/SDL.h>
 
+#include <bitset>
+#include <memory>
+
 namespace robikzinputtest {
 
 class App;
@@ -9,6 +14,8 @@ class Controller;
 
 class ControllerHandler {
 public:
+	virtual ~ControllerHandler() = default;
+
 	virtual bool handle_event(
 		App &app,
 		Controller &controller,
@@ -23,8 +30,66 @@ public:
 		Controller &controller,
 		const SDL_Event &event
 	) override;
+
+private:
+	/// Held buttons past the button channels, by their index.
+	std::bitset<256> m_untracked_buttons;
+};
+
+/**
+ * Handles the joysticks that SDL has a gamepad mapping for.
+ *
+ * The raw joystick events are translated to logical gamepad controls
+ * through the device's GamepadMapping, which is resolved once when the
+ * handler is created. This way any gamepad layout known to SDL works,
+ * and not just the XBox-like one.
+ */
+class GamepadControllerHandler : public ControllerHandler {
+public:
+	GamepadControllerHandler(SDL_JoystickID joystick_id);
+	~GamepadControllerHandler() override;
+
+	/// Whether the gamepad could be opened and its mapping resolved.
+	bool valid() const;
+
+	bool handle_event(
+		App &app,
+		Controller &controller,
+		const SDL_Event &event
+	) override;
+
+private:
+	struct D;
+	std::unique_ptr<D> d;
+};
+
+/**
+ * Mouse handler that moves by the relative motion of the mouse.
+ *
+ * A high-rate mouse sends many motion events per frame; they are
+ * summed up with their sub-pixel fractions intact.
+ */
+class MouseControllerHandler : public ControllerHandler {
+public:
+	MouseControllerHandler(SDL_MouseID mouse_id)
+		: m_mouse_id(mouse_id) {}
+
+	bool handle_event(
+		App &app,
+		Controller &controller,
+		const SDL_Event &event
+	) override;
+
+private:
+	SDL_MouseID m_mouse_id;
 };
 
+/**
+ * Keyboard handler that moves with WASD or the arrows.
+ *
+ * The keys are taken by their position (scancode), so that opposing keys
+ * held together cancel out instead of the last one winning.
+ */
 class KeyboardControllerHandler : public ControllerHandler {
 public:
 	bool handle_event(
@@ -32,6 +97,9 @@ public:
 		Controller &controller,
 		const SDL_Event &event
 	) override;
+
+private:
+	KeyboardState m_keyboard;
 };
 
 } // namespace robikzinputtest
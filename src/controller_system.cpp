@@ -6,11 +6,51 @@
 
 namespace robikzinputtest {
 
+/**
+ * Pick the handler for the joystick; gamepads known to SDL get
+ * their layout mapped, other joysticks are treated as XBox-like.
+ */
+static std::shared_ptr<ControllerHandler> create_joystick_handler(SDL_JoystickID which) {
+	if (SDL_IsGamepad(which)) {
+		auto gamepad_handler = std::make_shared<GamepadControllerHandler>(which);
+		if (gamepad_handler->valid()) {
+			return gamepad_handler;
+		}
+	}
+	return std::make_shared<JoystickControllerHandler>();
+}
+
+/**
+ * Identity of the joystick that survives reconnecting it: the GUID,
+ * and the serial number or, lacking that, the device path.
+ */
+static std::string joystick_identity(SDL_JoystickID which) {
+	char guid[33];
+	SDL_GUIDToString(SDL_GetJoystickGUIDForID(which), guid, sizeof(guid));
+	std::string identity = guid;
+
+	SDL_Joystick *joystick = SDL_GetJoystickFromID(which);
+	const char *serial = joystick != nullptr ? SDL_GetJoystickSerial(joystick) : nullptr;
+	const char *path = SDL_GetJoystickPathForID(which);
+	if (serial != nullptr && *serial != '\0') {
+		identity += "_";
+		identity += serial;
+	} else if (path != nullptr && *path != '\0') {
+		identity += "_";
+		identity += path;
+	}
+	return identity;
+}
+
 struct ControllerSystem::D {
 	App &app;
 
 	std::shared_ptr<Controller> m_keyboard_controller;
+	/// Connected joysticks.
 	std::map<SDL_JoystickID, std::shared_ptr<Controller>> m_joystick_controllers;
+	/// Every joystick seen during the session, by the controller identifier.
+	std::map<std::string, std::shared_ptr<Controller>> m_joystick_pool;
+	std::map<SDL_MouseID, std::shared_ptr<Controller>> m_mouse_controllers;
 
 	D(App &app) : app(app) {}
 };
@@ -41,28 +81,101 @@ std::shared_ptr<Controller> ControllerSystem::find_controller_by_id(
 			return it.second;
 		}
 	}
+	for (auto it : d->m_mouse_controllers) {
+		if (it.second->id == id) {
+			return it.second;
+		}
+	}
 	return nullptr;
 }
 
 Controller &ControllerSystem::for_joystick(SDL_JoystickID which) {
 	auto it = d->m_joystick_controllers.find(which);
 	if (it == d->m_joystick_controllers.end()) {
+		const std::string identity = joystick_identity(which);
+		std::shared_ptr<Controller> joystick_controller;
+		// Identical devices without a serial number are told apart by
+		// the order they got connected in.
+		for (int instance = 1; !joystick_controller; ++instance) {
+			std::stringstream ss;
+			ss << "joystick_" << identity;
+			if (instance > 1) {
+				ss << "#" << instance;
+			}
+			const std::string identifier = ss.str();
+			auto pooled = d->m_joystick_pool.find(identifier);
+			if (pooled == d->m_joystick_pool.end()) {
+				const ControllerId controller_id = {
+					.type = ControllerId::TYPE_JOY,
+					.identifier = identifier,
+					.index = which,
+				};
+				joystick_controller = std::make_shared<Controller>(controller_id);
+				d->m_joystick_pool.insert({identifier, joystick_controller});
+			} else if (pooled->second->id.index == 0) {
+				joystick_controller = pooled->second;
+				joystick_controller->id.index = which;
+			}
+		}
+		joystick_controller->set_handler(create_joystick_handler(which));
+		it = d->m_joystick_controllers.insert({which, joystick_controller}).first;
+	}
+	return *it->second;
+}
+
+void ControllerSystem::retire_joystick(SDL_JoystickID which) {
+	auto it = d->m_joystick_controllers.find(which);
+	if (it == d->m_joystick_controllers.end()) {
+		return;
+	}
+	// Let go of the device, but keep the statistics.
+	it->second->set_handler(nullptr);
+	it->second->id.index = 0;
+	d->m_joystick_controllers.erase(it);
+}
+
+Controller &ControllerSystem::for_keyboard() {
+	return *d->m_keyboard_controller;
+}
+
+Controller &ControllerSystem::for_mouse(SDL_MouseID which) {
+	auto it = d->m_mouse_controllers.find(which);
+	if (it == d->m_mouse_controllers.end()) {
 		std::stringstream ss;
-		ss << "joystick_" << which;
+		ss << "mouse_" << which;
 		const ControllerId controller_id = {
-			.type = ControllerId::TYPE_JOY,
+			.type = ControllerId::TYPE_MOUSE,
 			.identifier = ss.str(),
 			.index = which,
 		};
-		auto joystick_controller = std::make_shared<Controller>(controller_id);
-		joystick_controller->set_handler(std::make_shared<JoystickControllerHandler>());
-		it = d->m_joystick_controllers.insert({which, joystick_controller}).first;
+		auto mouse_controller = std::make_shared<Controller>(controller_id);
+		mouse_controller->set_handler(std::make_shared<MouseControllerHandler>(which));
+		it = d->m_mouse_controllers.insert({which, mouse_controller}).first;
 	}
 	return *it->second;
 }
 
-Controller &ControllerSystem::for_keyboard() {
-	return *d->m_keyboard_controller;
+void ControllerSystem::retire_mouse(SDL_MouseID which) {
+	auto it = d->m_mouse_controllers.find(which);
+	if (it == d->m_mouse_controllers.end()) {
+		return;
+	}
+	it->second->set_handler(nullptr);
+	d->m_mouse_controllers.erase(it);
+}
+
+const Controller *ControllerSystem::find_joystick(SDL_JoystickID which) const {
+	auto it = d->m_joystick_controllers.find(which);
+	return it != d->m_joystick_controllers.end() ? it->second.get() : nullptr;
+}
+
+const Controller *ControllerSystem::find_keyboard() const {
+	return d->m_keyboard_controller.get();
+}
+
+const Controller *ControllerSystem::find_mouse(SDL_MouseID which) const {
+	auto it = d->m_mouse_controllers.find(which);
+	return it != d->m_mouse_controllers.end() ? it->second.get() : nullptr;
 }
 
 bool ControllerSystem::handle_event(const SDL_Event &event) {
@@ -74,7 +187,21 @@ bool ControllerSystem::handle_event(const SDL_Event &event) {
 		if (it.second->handle_event(d->app, event))
 			return true;
 	}
+	for (auto it : d->m_mouse_controllers) {
+		if (it.second->handle_event(d->app, event))
+			return true;
+	}
 	return false;
 }
 
+void ControllerSystem::frame_presented(Uint64 present_ns) {
+	d->m_keyboard_controller->frame_presented(present_ns);
+	for (auto &it : d->m_joystick_controllers) {
+		it.second->frame_presented(present_ns);
+	}
+	for (auto &it : d->m_mouse_controllers) {
+		it.second->frame_presented(present_ns);
+	}
+}
+
 } // namespace robikzinputtest
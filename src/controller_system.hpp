@@ -16,11 +16,29 @@ public:
 
 	std::shared_ptr<Controller> find_controller_by_id(const ControllerId &id);
 
+	/**
+	 * The controller of the joystick. A joystick that was connected
+	 * before gets its old controller back, so its statistics carry
+	 * over. The joystick should be opened.
+	 */
 	Controller &for_joystick(SDL_JoystickID which);
+	/// Unbind the joystick's controller; it's kept for a reconnect.
+	void retire_joystick(SDL_JoystickID which);
 	Controller &for_keyboard();
+	Controller &for_mouse(SDL_MouseID which);
+	/// Drop the mouse's controller; a reconnected mouse gets a new ID.
+	void retire_mouse(SDL_MouseID which);
+
+	/// Lookups that don't create the controller; nullptr if there's none yet.
+	const Controller *find_joystick(SDL_JoystickID which) const;
+	const Controller *find_keyboard() const;
+	const Controller *find_mouse(SDL_MouseID which) const;
 
 	bool handle_event(const SDL_Event &event);
 
+	/// Tell the controllers that a frame got presented, for their button latency.
+	void frame_presented(Uint64 present_ns);
+
 private:
 	struct D;
 	std::unique_ptr<D> d;
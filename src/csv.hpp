@@ -0,0 +1,19 @@
+#pragma once
+
+#include <ostream>
+
+namespace robikzinputtest {
+
+/// Write the text as a quoted CSV field.
+inline void write_csv_text(std::ostream &out, const char *text) {
+	out << '"';
+	for (const char *c = text; *c != '\0'; ++c) {
+		if (*c == '"') {
+			out << '"';
+		}
+		out << *c;
+	}
+	out << '"';
+}
+
+} // namespace robikzinputtest
@@ -0,0 +1,51 @@
+#include "display_registry.hpp"
+
+#include <cstdio>
+
+namespace robikzinputtest {
+
+void format_resolution_label(char *buffer, size_t size, const DisplaySettings &display_settings) {
+	std::snprintf(
+		buffer, size, "%dx%d @ %fHz",
+		display_settings.width,
+		display_settings.height,
+		display_settings.refresh_rate
+	);
+}
+
+void DisplayRegistry::refresh() {
+	m_displays.clear();
+	for (const DisplayInfo &info : get_available_displays_info()) {
+		DisplayEntry entry;
+		entry.info = info;
+		entry.label = std::to_string(info.id) + ": " + info.name;
+		entry.modes = get_available_display_modes(info.id);
+		entry.mode_labels.reserve(entry.modes.size());
+		for (const VideoModeSettings &mode : entry.modes) {
+			char label[RESOLUTION_LABEL_SIZE];
+			format_resolution_label(label, sizeof(label), mode.display_settings);
+			entry.mode_labels.push_back(label);
+		}
+		m_displays.push_back(std::move(entry));
+	}
+	++m_generation;
+}
+
+bool DisplayRegistry::handle_event(const SDL_Event &event) {
+	if (event.type < SDL_EVENT_DISPLAY_FIRST || event.type > SDL_EVENT_DISPLAY_LAST) {
+		return false;
+	}
+	refresh();
+	return true;
+}
+
+const DisplayEntry *DisplayRegistry::find(SDL_DisplayID display_id) const {
+	for (const DisplayEntry &entry : m_displays) {
+		if (entry.info.id == display_id) {
+			return &entry;
+		}
+	}
+	return nullptr;
+}
+
+} // namespace robikzinputtest
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "video.hpp"
+
+#include <SDL3/SDL.h>
+
+#include <string>
+#include <vector>
+
+namespace robikzinputtest {
+
+/**
+ * A display and its fullscreen modes, with their labels made ahead.
+ */
+struct DisplayEntry {
+	DisplayInfo info;
+	/// "ID: name"
+	std::string label;
+	std::vector<VideoModeSettings> modes;
+	/// "WxH @ RATEHz" of each mode.
+	std::vector<std::string> mode_labels;
+};
+
+/**
+ * The displays and their fullscreen modes, enumerated once and again
+ * only when SDL reports a display change, so that they can be shown
+ * every frame without querying SDL.
+ */
+class DisplayRegistry {
+public:
+	/// Enumerate the displays and their modes anew.
+	void refresh();
+	/// Refresh on a display event; returns true if it was one.
+	bool handle_event(const SDL_Event &event);
+
+	const std::vector<DisplayEntry> &displays() const { return m_displays; }
+	/// The display, or nullptr if it isn't connected.
+	const DisplayEntry *find(SDL_DisplayID display_id) const;
+	/// Increases with each refresh.
+	unsigned generation() const { return m_generation; }
+
+private:
+	std::vector<DisplayEntry> m_displays;
+	unsigned m_generation = 0;
+};
+
+/// Room for a resolution label; a float refresh rate may have many digits.
+constexpr size_t RESOLUTION_LABEL_SIZE = 64;
+
+/**
+ * Write "WxH @ RATEHz" of the display settings into the buffer.
+ */
+void format_resolution_label(char *buffer, size_t size, const DisplaySettings &display_settings);
+
+} // namespace robikzinputtest
@@ -0,0 +1,71 @@
+#include "event_rate_monitor.hpp"
+
+#include <algorithm>
+
+namespace robikzinputtest {
+
+void EventRateMonitor::add_event(InputDeviceKind kind, Uint32 id) {
+	auto device = std::find_if(m_devices.begin(), m_devices.end(),
+		[kind, id](const DeviceEventRate &device) {
+			return device.kind == kind && device.id == id;
+		}
+	);
+	if (device == m_devices.end()) {
+		DeviceEventRate added;
+		added.kind = kind;
+		added.id = id;
+		added.label = std::string(input_device_kind_label(kind)) + " " + std::to_string(id);
+		m_devices.push_back(std::move(added));
+		device = m_devices.end() - 1;
+	}
+	++device->bin_events;
+}
+
+void EventRateMonitor::update(Uint64 now_ns) {
+	if (m_bin_start_ns == 0) {
+		m_bin_start_ns = now_ns;
+		return;
+	}
+	if (now_ns < m_bin_start_ns + BIN_NS) {
+		return;
+	}
+	// After a stall the missed bins count as silent, up to a full history.
+	const Uint64 bins = std::min<Uint64>((now_ns - m_bin_start_ns) / BIN_NS, Rates::CAPACITY);
+	m_bin_start_ns = now_ns - (now_ns - m_bin_start_ns) % BIN_NS;
+	const float per_second = 1e9f / static_cast<float>(BIN_NS);
+	for (DeviceEventRate &device : m_devices) {
+		for (Uint64 bin = 0; bin < bins; ++bin) {
+			const uint64_t events = bin == 0 ? device.bin_events : 0;
+			device.rates.push(static_cast<float>(events) * per_second);
+			device.silent_bins = events > 0 ? 0 : device.silent_bins + 1;
+		}
+		device.bin_events = 0;
+	}
+	m_devices.erase(
+		std::remove_if(m_devices.begin(), m_devices.end(),
+			[](const DeviceEventRate &device) {
+				return device.silent_bins >= Rates::CAPACITY;
+			}
+		),
+		m_devices.end()
+	);
+}
+
+void EventRateMonitor::clear() {
+	m_devices.clear();
+	m_bin_start_ns = 0;
+}
+
+const char *input_device_kind_label(InputDeviceKind kind) {
+	switch (kind) {
+	case InputDeviceKind::KEYBOARD:
+		return "Keyboard";
+	case InputDeviceKind::JOYSTICK:
+		return "Joystick";
+	case InputDeviceKind::MOUSE:
+		return "Mouse";
+	}
+	return "?";
+}
+
+} // namespace robikzinputtest
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "frame_profiler.hpp"
+
+#include <SDL3/SDL.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace robikzinputtest {
+
+enum class InputDeviceKind {
+	KEYBOARD,
+	JOYSTICK,
+	MOUSE,
+};
+
+/**
+ * Recent event rates of one input device.
+ */
+struct DeviceEventRate {
+	InputDeviceKind kind = InputDeviceKind::KEYBOARD;
+	/// SDL instance ID of the device, within its kind.
+	Uint32 id = 0;
+	/// Kind and ID, for display.
+	std::string label;
+	/// Events per second of the recent bins, oldest first; plotted with the frames.
+	FrameProfiler::History rates;
+	/// Events in the bin being filled.
+	uint64_t bin_events = 0;
+	/// Consecutive bins without events.
+	size_t silent_bins = 0;
+};
+
+/**
+ * Rolling rate of the events of every input device.
+ *
+ * Events are counted into BIN_NS long bins; each completed bin adds
+ * one rate to every device's history. A device that stays silent for
+ * the whole history, usually one that was disconnected, is dropped.
+ */
+class EventRateMonitor {
+public:
+	static constexpr Uint64 BIN_NS = 250'000'000;
+
+	using Rates = FrameProfiler::History;
+
+	/// Count an event of the device.
+	void add_event(InputDeviceKind kind, Uint32 id);
+	/// Complete the bins that ended by now_ns, in SDL_GetTicksNS().
+	void update(Uint64 now_ns);
+	void clear();
+
+	const std::vector<DeviceEventRate> &devices() const { return m_devices; }
+
+private:
+	std::vector<DeviceEventRate> m_devices;
+	/// Start of the bin being filled; 0 before the first update.
+	Uint64 m_bin_start_ns = 0;
+};
+
+const char *input_device_kind_label(InputDeviceKind kind);
+
+} // namespace robikzinputtest
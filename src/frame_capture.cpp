@@ -0,0 +1,325 @@
+#include "frame_capture.hpp"
+
+#include "text.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace robikzinputtest {
+
+static const char *const Y4M_EXTENSION = ".y4m";
+static const int DEFAULT_RATE = 60;
+
+/**
+ * A frame read back and waiting for the worker.
+ *
+ * SDL_RenderReadPixels() allocates the surface itself, so the slot
+ * owns it until the worker is done with it.
+ */
+struct CaptureSlot {
+	SDL_Surface *surface = nullptr;
+	/// Number of the frame among all the rendered ones.
+	uint64_t frame = 0;
+};
+
+/**
+ * Full-range BT.601 RGB to YCbCr, in 8.8 fixed point; the video header
+ * declares the range, as players assume the limited one otherwise.
+ */
+static Uint8 rgb_to_y(int r, int g, int b) {
+	return static_cast<Uint8>((77 * r + 150 * g + 29 * b + 128) >> 8);
+}
+
+static Uint8 rgb_to_cb(int r, int g, int b) {
+	return static_cast<Uint8>(std::min((-43 * r - 85 * g + 128 * b + (128 << 8) + 128) >> 8, 255));
+}
+
+static Uint8 rgb_to_cr(int r, int g, int b) {
+	return static_cast<Uint8>(std::min((128 * r - 107 * g - 21 * b + (128 << 8) + 128) >> 8, 255));
+}
+
+/**
+ * Convert RGBA32 pixels to planar 4:2:0 YCbCr; each chroma sample
+ * is the average of a 2x2 block, clamped at the odd edges.
+ */
+static void rgba_to_yuv420(const SDL_Surface &rgba, std::vector<Uint8> &out) {
+	const int w = rgba.w;
+	const int h = rgba.h;
+	const int cw = (w + 1) / 2;
+	const int ch = (h + 1) / 2;
+	out.resize(static_cast<size_t>(w) * h + 2 * static_cast<size_t>(cw) * ch);
+	Uint8 *y_plane = out.data();
+	Uint8 *cb_plane = y_plane + static_cast<size_t>(w) * h;
+	Uint8 *cr_plane = cb_plane + static_cast<size_t>(cw) * ch;
+
+	auto pixel = [&rgba](int x, int y) {
+		return static_cast<const Uint8 *>(rgba.pixels) + static_cast<size_t>(y) * rgba.pitch + 4 * x;
+	};
+	for (int y = 0; y < h; ++y) {
+		for (int x = 0; x < w; ++x) {
+			const Uint8 *p = pixel(x, y);
+			y_plane[static_cast<size_t>(y) * w + x] = rgb_to_y(p[0], p[1], p[2]);
+		}
+	}
+	for (int cy = 0; cy < ch; ++cy) {
+		const int y0 = 2 * cy;
+		const int y1 = std::min(y0 + 1, h - 1);
+		for (int cx = 0; cx < cw; ++cx) {
+			const int x0 = 2 * cx;
+			const int x1 = std::min(x0 + 1, w - 1);
+			const Uint8 *p[4] = { pixel(x0, y0), pixel(x1, y0), pixel(x0, y1), pixel(x1, y1) };
+			const int r = (p[0][0] + p[1][0] + p[2][0] + p[3][0] + 2) / 4;
+			const int g = (p[0][1] + p[1][1] + p[2][1] + p[3][1] + 2) / 4;
+			const int b = (p[0][2] + p[1][2] + p[2][2] + p[3][2] + 2) / 4;
+			cb_plane[static_cast<size_t>(cy) * cw + cx] = rgb_to_cb(r, g, b);
+			cr_plane[static_cast<size_t>(cy) * cw + cx] = rgb_to_cr(r, g, b);
+		}
+	}
+}
+
+struct FrameCapture::D {
+	int every_nth;
+	std::vector<CaptureSlot> slots;
+
+	// Main thread
+	std::string path;
+	bool video = false;
+	int rate_numerator = DEFAULT_RATE;
+	int rate_denominator = 1;
+	uint64_t frame = 0;
+
+	// Worker thread
+	SDL_IOStream *io = nullptr;
+	bool write_ok = true;
+	int video_w = 0;
+	int video_h = 0;
+	/// The last frame in the video; its pixels are still in yuv.
+	uint64_t video_frame = 0;
+	bool has_video_frame = false;
+	std::vector<Uint8> yuv;
+
+	// Shared with the worker
+	std::mutex mutex;
+	std::condition_variable wakeup;
+	std::vector<int> free_slots;
+	/// Filled slots in the order of the frames.
+	std::deque<int> ready_slots;
+	bool stopping = false;
+	std::atomic<uint64_t> written { 0 };
+	std::atomic<uint64_t> dropped { 0 };
+	std::atomic<uint64_t> repeated { 0 };
+
+	std::thread worker;
+
+	D(int every_nth, int staging_slots)
+		: every_nth(std::max(1, every_nth)),
+		slots(std::max(1, staging_slots)) {}
+
+	void run() {
+		std::unique_lock<std::mutex> lock(mutex);
+		for (;;) {
+			wakeup.wait(lock, [this]() { return !ready_slots.empty() || stopping; });
+			if (ready_slots.empty()) {
+				// Stopping with nothing left to write.
+				return;
+			}
+			const int index = ready_slots.front();
+			ready_slots.pop_front();
+			lock.unlock();
+			CaptureSlot &slot = slots[index];
+			write_frame(slot);
+			SDL_DestroySurface(slot.surface);
+			slot.surface = nullptr;
+			lock.lock();
+			free_slots.push_back(index);
+		}
+	}
+
+	void write_frame(const CaptureSlot &slot) {
+		// Converted here, as the render target's format varies by driver.
+		SDL_Surface *rgba = slot.surface->format == SDL_PIXELFORMAT_RGBA32
+			? slot.surface
+			: SDL_ConvertSurface(slot.surface, SDL_PIXELFORMAT_RGBA32);
+		if (rgba == nullptr) {
+			++dropped;
+			return;
+		}
+		const bool ok = video ? write_video_frame(*rgba, slot.frame) : write_image(*rgba, slot.frame);
+		if (rgba != slot.surface) {
+			SDL_DestroySurface(rgba);
+		}
+		if (ok) {
+			++written;
+		} else {
+			++dropped;
+		}
+	}
+
+	bool write_video_frame(const SDL_Surface &rgba, uint64_t frame) {
+		if (video_w == 0) {
+			video_w = rgba.w;
+			video_h = rgba.h;
+			char header[128];
+			const int length = std::snprintf(
+				header, sizeof(header), "YUV4MPEG2 W%d H%d F%d:%d Ip A1:1 C420jpeg XCOLORRANGE=FULL\n",
+				video_w, video_h, rate_numerator, rate_denominator
+			);
+			write_ok &= SDL_WriteIO(io, header, length) == static_cast<size_t>(length);
+		}
+		if (rgba.w != video_w || rgba.h != video_h) {
+			// The stream has one size; e.g. a resized window can't go in.
+			return false;
+		}
+		// The frames dropped since the last one take its place.
+		if (has_video_frame) {
+			for (uint64_t missing = video_frame + every_nth; missing < frame; missing += every_nth) {
+				write_yuv();
+				++repeated;
+			}
+		}
+		rgba_to_yuv420(rgba, yuv);
+		write_yuv();
+		video_frame = frame;
+		has_video_frame = true;
+		return write_ok;
+	}
+
+	void write_yuv() {
+		static const char FRAME_HEADER[] = "FRAME\n";
+		write_ok &= SDL_WriteIO(io, FRAME_HEADER, sizeof(FRAME_HEADER) - 1) == sizeof(FRAME_HEADER) - 1;
+		write_ok &= SDL_WriteIO(io, yuv.data(), yuv.size()) == yuv.size();
+	}
+
+	bool write_image(SDL_Surface &rgba, uint64_t frame) {
+		char name[32];
+		std::snprintf(name, sizeof(name), "/frame_%08llu.bmp", static_cast<unsigned long long>(frame));
+		if (!SDL_SaveBMP(&rgba, (path + name).c_str())) {
+			write_ok = false;
+			return false;
+		}
+		return true;
+	}
+};
+
+FrameCapture::FrameCapture(int every_nth, int staging_slots)
+	: d(std::make_unique<D>(every_nth, staging_slots)) {
+}
+
+FrameCapture::~FrameCapture() {
+	close();
+}
+
+bool FrameCapture::open(const std::string &path, int rate_numerator, int rate_denominator) {
+	close();
+	d->path = path;
+	d->video = path.size() >= 4 && text::equals_ignore_case(
+		std::string_view(path).substr(path.size() - 4), Y4M_EXTENSION);
+	const bool rate_known = rate_numerator > 0 && rate_denominator > 0;
+	d->rate_numerator = rate_known ? rate_numerator : DEFAULT_RATE;
+	d->rate_denominator = (rate_known ? rate_denominator : 1) * d->every_nth;
+	if (d->video) {
+		d->io = SDL_IOFromFile(path.c_str(), "wb");
+		if (d->io == nullptr) {
+			std::cerr << "Failed to open frame capture " << path << ": " << SDL_GetError() << std::endl;
+			return false;
+		}
+	} else if (!SDL_CreateDirectory(path.c_str())) {
+		std::cerr << "Failed to create frame capture directory " << path << ": " << SDL_GetError() << std::endl;
+		return false;
+	}
+
+	d->frame = 0;
+	d->write_ok = true;
+	d->video_w = 0;
+	d->video_h = 0;
+	d->video_frame = 0;
+	d->has_video_frame = false;
+	d->written = 0;
+	d->dropped = 0;
+	d->repeated = 0;
+	d->stopping = false;
+	d->free_slots.clear();
+	for (int i = static_cast<int>(d->slots.size()) - 1; i >= 0; --i) {
+		d->free_slots.push_back(i);
+	}
+	d->worker = std::thread([this]() { d->run(); });
+	return true;
+}
+
+void FrameCapture::capture(SDL_Renderer &renderer) {
+	if (!d->worker.joinable()) {
+		return;
+	}
+	const uint64_t frame = d->frame++;
+	if (frame % d->every_nth != 0) {
+		return;
+	}
+	int index;
+	{
+		std::lock_guard<std::mutex> lock(d->mutex);
+		if (d->free_slots.empty()) {
+			++d->dropped;
+			return;
+		}
+		index = d->free_slots.back();
+		d->free_slots.pop_back();
+	}
+	CaptureSlot &slot = d->slots[index];
+	slot.surface = SDL_RenderReadPixels(&renderer, nullptr);
+	slot.frame = frame;
+	std::lock_guard<std::mutex> lock(d->mutex);
+	if (slot.surface == nullptr) {
+		++d->dropped;
+		d->free_slots.push_back(index);
+		return;
+	}
+	d->ready_slots.push_back(index);
+	d->wakeup.notify_one();
+}
+
+void FrameCapture::close() {
+	if (!d->worker.joinable()) {
+		return;
+	}
+	{
+		std::lock_guard<std::mutex> lock(d->mutex);
+		d->stopping = true;
+	}
+	d->wakeup.notify_one();
+	d->worker.join();
+	if (d->io != nullptr) {
+		d->write_ok &= SDL_CloseIO(d->io);
+		d->io = nullptr;
+	}
+	if (!d->write_ok) {
+		std::cerr << "Frame capture is incomplete; some writes have failed" << std::endl;
+	}
+	std::cerr << "Frame capture: " << d->written << " frames written, "
+		<< d->dropped << " dropped";
+	if (d->video) {
+		std::cerr << ", " << d->repeated << " repeated in their place";
+	}
+	std::cerr << std::endl;
+}
+
+uint64_t FrameCapture::frames_written() const {
+	return d->written;
+}
+
+uint64_t FrameCapture::frames_dropped() const {
+	return d->dropped;
+}
+
+uint64_t FrameCapture::frames_repeated() const {
+	return d->repeated;
+}
+
+} // namespace robikzinputtest
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace robikzinputtest {
+
+/**
+ * Records the rendered frames to disk without holding up the render loop.
+ *
+ * Every Nth frame is read back from the render target into one of
+ * a rotating set of staging slots and handed to a worker thread, which
+ * converts and writes it. The slots bound the frames in flight: when
+ * the worker falls behind and none is free, the frame is dropped and
+ * counted, so the render loop never waits on the encoding or the disk.
+ *
+ * A path ending in ".y4m" is written as a YUV4MPEG2 video in full-range
+ * YCbCr with 4:2:0 chroma, which players and encoders read directly; its
+ * frames all have the size of the first one. A dropped frame is filled
+ * in with the one before it, so the video keeps the timeline of the
+ * rendered frames. Any other path is a directory that receives
+ * a numbered BMP image per frame.
+ */
+class FrameCapture {
+public:
+	static constexpr int DEFAULT_STAGING_SLOTS = 4;
+
+	FrameCapture(int every_nth = 1, int staging_slots = DEFAULT_STAGING_SLOTS);
+	/// Write the frames in flight and close the output.
+	~FrameCapture();
+
+	FrameCapture(const FrameCapture &) = delete;
+	FrameCapture &operator=(const FrameCapture &) = delete;
+
+	/**
+	 * Start writing to the path. The rate, in frames per second, is
+	 * the one the frames are paced at, 60 if the numerator is zero;
+	 * the video plays at it divided by every_nth. It's fixed for
+	 * the whole capture.
+	 */
+	bool open(const std::string &path, int rate_numerator, int rate_denominator);
+	/// Read the frame back if it's due; call when it's drawn, before present.
+	void capture(SDL_Renderer &renderer);
+	/// Write the frames in flight, close the output and print the counts.
+	void close();
+
+	uint64_t frames_written() const;
+	/// Frames skipped because no slot was free, or they had another size.
+	uint64_t frames_dropped() const;
+	/// Video frames written again in place of the dropped ones.
+	uint64_t frames_repeated() const;
+
+private:
+	struct D;
+	std::unique_ptr<D> d;
+};
+
+} // namespace robikzinputtest
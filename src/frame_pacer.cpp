@@ -0,0 +1,106 @@
+#include "frame_pacer.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace robikzinputtest {
+
+static constexpr Uint64 NS_PER_SECOND = 1'000'000'000;
+
+bool FramePacer::set_rate(int refresh_numerator, int refresh_denominator, int divisor, bool vsync) {
+	if (refresh_numerator <= 0 || refresh_denominator <= 0 || divisor <= 0) {
+		m_enabled = false;
+		return false;
+	}
+	m_phase_lock = vsync;
+	// period = denominator * divisor / numerator seconds
+	const Uint64 period_dividend =
+		static_cast<Uint64>(refresh_denominator) * static_cast<Uint64>(divisor) * NS_PER_SECOND;
+	const Uint64 period_divisor = static_cast<Uint64>(refresh_numerator);
+	const Uint64 period_ns = period_dividend / period_divisor;
+	const Uint64 period_remainder = period_dividend % period_divisor;
+	if (
+		m_enabled
+		&& period_ns == m_period_ns
+		&& period_remainder == m_period_remainder
+		&& period_divisor == m_period_divisor
+	) {
+		return true;
+	}
+	m_period_ns = period_ns;
+	m_period_remainder = period_remainder;
+	m_period_divisor = period_divisor;
+	m_remainder_sum = 0;
+	m_next_present_ns = 0;
+	m_phase_error_ns = 0.0;
+	m_enabled = true;
+	return true;
+}
+
+double FramePacer::rate_hz() const {
+	if (!m_enabled) {
+		return 0.0;
+	}
+	const double period_ns = static_cast<double>(m_period_ns)
+		+ static_cast<double>(m_period_remainder) / static_cast<double>(m_period_divisor);
+	return static_cast<double>(NS_PER_SECOND) / period_ns;
+}
+
+void FramePacer::advance_grid() {
+	m_next_present_ns += m_period_ns;
+	m_remainder_sum += m_period_remainder;
+	if (m_remainder_sum >= m_period_divisor) {
+		m_remainder_sum -= m_period_divisor;
+		++m_next_present_ns;
+	}
+}
+
+void FramePacer::wait() {
+	if (m_enabled && m_next_present_ns != 0) {
+		const Uint64 lead_ns = std::min(
+			static_cast<Uint64>(m_render_time_ns) + LEAD_MARGIN_NS,
+			m_period_ns
+		);
+		const Uint64 tick_at_ns = m_next_present_ns - lead_ns;
+		const Uint64 now_ns = SDL_GetTicksNS();
+		if (tick_at_ns > now_ns) {
+			SDL_DelayPrecise(tick_at_ns - now_ns);
+		}
+	}
+	m_tick_ns = SDL_GetTicksNS();
+}
+
+void FramePacer::presented(Uint64 submit_ns, Uint64 present_ns) {
+	if (!m_enabled) {
+		return;
+	}
+	// Rendering ends at the submit; the present may block on vsync.
+	const double render_time_ns = static_cast<double>(submit_ns - m_tick_ns);
+	if (m_next_present_ns == 0) {
+		m_render_time_ns = render_time_ns;
+	} else {
+		m_render_time_ns += (render_time_ns - m_render_time_ns) * AVERAGE_WEIGHT;
+	}
+
+	if (m_next_present_ns == 0) {
+		// The first present sets the grid.
+		m_next_present_ns = present_ns;
+		advance_grid();
+		return;
+	}
+	const double error_ns = static_cast<double>(static_cast<int64_t>(present_ns - m_next_present_ns));
+	if (std::abs(error_ns) * 2.0 > static_cast<double>(m_period_ns)) {
+		// A missed or early frame is off the grid; start it over here.
+		m_next_present_ns = present_ns;
+		m_phase_error_ns = 0.0;
+		++m_resyncs;
+	} else {
+		if (m_phase_lock) {
+			m_next_present_ns += static_cast<int64_t>(error_ns * PHASE_GAIN);
+		}
+		m_phase_error_ns += (error_ns - m_phase_error_ns) * AVERAGE_WEIGHT;
+	}
+	advance_grid();
+}
+
+} // namespace robikzinputtest
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+
+#include <cstdint>
+
+namespace robikzinputtest {
+
+/**
+ * Paces the frames to an exact fraction of the display refresh rate.
+ *
+ * The period comes from the rational refresh rate of the display mode,
+ * e.g. 60000/1001 Hz, and is stepped without rounding error, so the
+ * frames never drift against the panel. The presents are expected on
+ * a grid of that period, and the next tick is scheduled ahead of the
+ * next grid point by the time a frame takes to render.
+ *
+ * With vsync, a present returns at a vertical blank, so each measured
+ * present nudges the grid toward it (phase lock). Without vsync, the
+ * presents carry no panel timing and the grid runs free.
+ */
+class FramePacer {
+public:
+	/// Fraction of the phase error corrected on each present.
+	static constexpr double PHASE_GAIN = 0.1;
+	/// Weight of the newest frame in the averages.
+	static constexpr double AVERAGE_WEIGHT = 1.0 / 16.0;
+	/// Slack between the expected end of rendering and the present.
+	static constexpr Uint64 LEAD_MARGIN_NS = 500'000;
+	static constexpr int MAX_DIVISOR = 8;
+
+	/**
+	 * Pace to refresh_numerator / refresh_denominator Hz divided by
+	 * the divisor. The schedule restarts only if the period changed.
+	 * Returns false, and disables the pacing, for an unknown rate.
+	 */
+	bool set_rate(int refresh_numerator, int refresh_denominator, int divisor, bool vsync);
+	void disable() { m_enabled = false; }
+	bool enabled() const { return m_enabled; }
+
+	/// Sleep until the next tick is due.
+	void wait();
+	/**
+	 * The frame was submitted at submit_ns and the present returned
+	 * at present_ns.
+	 */
+	void presented(Uint64 submit_ns, Uint64 present_ns);
+
+	double rate_hz() const;
+	/// Smoothed distance of the presents from the grid.
+	double phase_error_ns() const { return m_phase_error_ns; }
+	/// Presents that fell off the grid and restarted it.
+	uint64_t resyncs() const { return m_resyncs; }
+
+private:
+	bool m_enabled = false;
+	bool m_phase_lock = false;
+
+	// The period is m_period_ns + m_period_remainder / m_period_divisor.
+	Uint64 m_period_ns = 0;
+	Uint64 m_period_remainder = 0;
+	Uint64 m_period_divisor = 1;
+	/// Accumulated remainder, in 1/m_period_divisor ns.
+	Uint64 m_remainder_sum = 0;
+
+	/// Grid point where the next present is expected; 0 before the first.
+	Uint64 m_next_present_ns = 0;
+	Uint64 m_tick_ns = 0;
+	double m_render_time_ns = 0.0;
+	double m_phase_error_ns = 0.0;
+	uint64_t m_resyncs = 0;
+
+	void advance_grid();
+};
+
+} // namespace robikzinputtest
@@ -0,0 +1,108 @@
+#include "frame_profiler.hpp"
+
+#include "alloc_counter.hpp"
+
+#include <iomanip>
+
+namespace robikzinputtest {
+
+static float ns_to_ms(Uint64 ns) {
+	return static_cast<float>(static_cast<double>(ns) / 1e6);
+}
+
+void FrameProfiler::begin_frame(Uint64 now_ns) {
+	const uint64_t allocations = alloc_counter::count();
+	if (m_frames > 0) {
+		end_phase(FramePhase::IDLE, now_ns);
+		m_intervals.push(ns_to_ms(now_ns >= m_frame_start_ns ? now_ns - m_frame_start_ns : 0));
+		m_allocations.push(static_cast<float>(allocations - m_frame_start_allocations));
+	}
+	m_frame_start_ns = now_ns;
+	m_frame_start_allocations = allocations;
+	m_mark_ns = now_ns;
+	++m_frames;
+}
+
+void FrameProfiler::end_phase(FramePhase phase, Uint64 now_ns) {
+	const Uint64 duration_ns = now_ns >= m_mark_ns ? now_ns - m_mark_ns : 0;
+	m_mark_ns = now_ns;
+	const size_t index = static_cast<size_t>(phase);
+	m_history[index].push(ns_to_ms(duration_ns));
+	m_total_ns[index] += duration_ns;
+	if (phase == FramePhase::GUI) {
+		m_last_gui_ns = duration_ns;
+	}
+}
+
+void FrameProfiler::gui_frame(GuiFrame kind) {
+	GuiTally &tally = m_gui[static_cast<size_t>(kind)];
+	++tally.frames;
+	tally.total_ns += m_last_gui_ns;
+}
+
+void FrameProfiler::input_latency(uint64_t latency_us) {
+	m_latencies.push(static_cast<float>(static_cast<double>(latency_us) / 1e3));
+}
+
+double FrameProfiler::gui_mean_ms(GuiFrame kind) const {
+	const GuiTally &tally = m_gui[static_cast<size_t>(kind)];
+	if (tally.frames == 0) {
+		return 0.0;
+	}
+	return static_cast<double>(tally.total_ns) / static_cast<double>(tally.frames) / 1e6;
+}
+
+double FrameProfiler::gui_saved_ms() const {
+	const double full_ms = gui_mean_ms(GuiFrame::FULL);
+	double saved_ms = 0.0;
+	for (GuiFrame kind : { GuiFrame::CACHED, GuiFrame::SKIPPED }) {
+		saved_ms += static_cast<double>(gui_frames(kind)) * (full_ms - gui_mean_ms(kind));
+	}
+	return saved_ms;
+}
+
+void FrameProfiler::write_report(std::ostream &out) const {
+	if (m_frames == 0) {
+		return;
+	}
+	out << "Frame phases, mean ms over " << m_frames << " frames:";
+	out << std::fixed << std::setprecision(3);
+	for (size_t i = 0; i < PHASE_COUNT; ++i) {
+		out << " " << frame_phase_label(static_cast<FramePhase>(i)) << " "
+			<< static_cast<double>(m_total_ns[i]) / static_cast<double>(m_frames) / 1e6;
+	}
+	out << std::endl;
+	out << "GUI frames: full " << gui_frames(GuiFrame::FULL)
+		<< " (" << gui_mean_ms(GuiFrame::FULL) << " ms)"
+		<< ", cached " << gui_frames(GuiFrame::CACHED)
+		<< " (" << gui_mean_ms(GuiFrame::CACHED) << " ms)"
+		<< ", skipped " << gui_frames(GuiFrame::SKIPPED)
+		<< " (" << gui_mean_ms(GuiFrame::SKIPPED) << " ms)"
+		<< ", saved " << gui_saved_ms() << " ms"
+		<< std::endl;
+	out << std::defaultfloat;
+}
+
+const char *frame_phase_label(FramePhase phase) {
+	switch (phase) {
+	case FramePhase::EVENTS:
+		return "events";
+	case FramePhase::UPDATE:
+		return "update";
+	case FramePhase::RENDER:
+		return "render";
+	case FramePhase::GUI:
+		return "gui";
+	case FramePhase::READBACK:
+		return "readback";
+	case FramePhase::PRESENT:
+		return "present";
+	case FramePhase::IDLE:
+		return "idle";
+	case FramePhase::COUNT:
+		break;
+	}
+	return "?";
+}
+
+} // namespace robikzinputtest
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "ring_buffer.hpp"
+
+#include <SDL3/SDL.h>
+
+#include <array>
+#include <cstdint>
+#include <ostream>
+
+namespace robikzinputtest {
+
+/// Consecutive phases of a frame, in the order they run.
+enum class FramePhase {
+	EVENTS,
+	UPDATE,
+	RENDER,
+	GUI,
+	/// Self-test and frame capture readbacks.
+	READBACK,
+	PRESENT,
+	/**
+	 * From the present to the start of the next frame: the bookkeeping
+	 * after the present, the frame pacer's wait and the clock tick.
+	 */
+	IDLE,
+	COUNT,
+};
+
+/// How the GUI produced its part of the frame.
+enum class GuiFrame {
+	/// A new ImGui frame was built and drawn.
+	FULL,
+	/// The previous frame's draw data was drawn again.
+	CACHED,
+	/// ImGui was skipped altogether, in the measurement mode.
+	SKIPPED,
+	COUNT,
+};
+
+/**
+ * Per-phase cost of the frames.
+ *
+ * Each phase is measured from the end of the previous one, and IDLE
+ * runs up to the start of the next frame, so the phases add up to the
+ * interval between the frames. The recent history is kept for
+ * plotting, and the GUI frames are tallied by how they were produced,
+ * which tells what the GUI cache and the measurement mode save.
+ *
+ * Along the phases go the interval between the frames, the heap
+ * allocations each frame made, and the input-to-present latency of
+ * the frames that carried input.
+ */
+class FrameProfiler {
+public:
+	static constexpr size_t HISTORY = 240;
+	static constexpr size_t PHASE_COUNT = static_cast<size_t>(FramePhase::COUNT);
+	static constexpr size_t GUI_FRAME_COUNT = static_cast<size_t>(GuiFrame::COUNT);
+
+	using History = RingBuffer<float, HISTORY>;
+
+	/// Ends the previous frame's IDLE phase.
+	void begin_frame(Uint64 now_ns);
+	/// The phase ended at now_ns.
+	void end_phase(FramePhase phase, Uint64 now_ns);
+	/// The GUI phase, which just ended, made its frame this way.
+	void gui_frame(GuiFrame kind);
+	/// The frame just presented showed input that came this long before.
+	void input_latency(uint64_t latency_us);
+
+	/// Recent durations of the phase, in ms.
+	const History &history(FramePhase phase) const {
+		return m_history[static_cast<size_t>(phase)];
+	}
+	/// Recent intervals between the starts of the frames, in ms.
+	const History &frame_intervals() const { return m_intervals; }
+	/// Heap allocations of the recent frames.
+	const History &allocations() const { return m_allocations; }
+	/// Input-to-present latency of the recent frames with input, in ms.
+	const History &latencies() const { return m_latencies; }
+	uint64_t gui_frames(GuiFrame kind) const {
+		return m_gui[static_cast<size_t>(kind)].frames;
+	}
+	/// Mean GUI phase of the frames of the kind, in ms.
+	double gui_mean_ms(GuiFrame kind) const;
+	/**
+	 * GUI time not spent thanks to the cached and skipped frames, in ms,
+	 * estimated from the mean cost of the full frames.
+	 */
+	double gui_saved_ms() const;
+
+	void write_report(std::ostream &out) const;
+
+private:
+	struct GuiTally {
+		uint64_t frames = 0;
+		Uint64 total_ns = 0;
+	};
+
+	std::array<History, PHASE_COUNT> m_history;
+	History m_intervals;
+	History m_allocations;
+	History m_latencies;
+	std::array<Uint64, PHASE_COUNT> m_total_ns {};
+	uint64_t m_frames = 0;
+	std::array<GuiTally, GUI_FRAME_COUNT> m_gui {};
+	Uint64 m_mark_ns = 0;
+	Uint64 m_frame_start_ns = 0;
+	uint64_t m_frame_start_allocations = 0;
+	Uint64 m_last_gui_ns = 0;
+};
+
+const char *frame_phase_label(FramePhase phase);
+
+} // namespace robikzinputtest
@@ -0,0 +1,54 @@
+/**
+ * @file
+ * libFuzzer entry point for the properties file parser.
+ *
+ * Built with the ROBIKZINPUTTEST_FUZZ CMake option. Besides not
+ * crashing, the properties must survive a write and a read back, and
+ * the settings must import anything.
+ */
+#include "properties_file.hpp"
+#include "settings.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <string_view>
+
+using namespace robikzinputtest;
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+	const std::string_view text(reinterpret_cast<const char *>(data), size);
+
+	const std::vector<PropertyView> views = parse_properties(text);
+	for (const PropertyView &view : views) {
+		// The views point into the text.
+		if (view.name.data() < text.data() || view.name.data() + view.name.size() > text.data() + text.size()) {
+			std::abort();
+		}
+		if (view.value.data() < text.data() || view.value.data() + view.value.size() > text.data() + text.size()) {
+			std::abort();
+		}
+	}
+
+	const std::vector<Property> properties = read_properties(text);
+	if (properties.size() != views.size()) {
+		std::abort();
+	}
+	const std::string written = write_properties(properties);
+	const std::vector<Property> reread = read_properties(written);
+	if (reread.size() != properties.size()) {
+		std::abort();
+	}
+	for (size_t i = 0; i < properties.size(); ++i) {
+		if (
+			reread[i].name != properties[i].name
+			|| reread[i].value.as_string() != properties[i].value.as_string()
+		) {
+			std::abort();
+		}
+	}
+
+	Settings settings;
+	settings.import_properties(views);
+	return 0;
+}
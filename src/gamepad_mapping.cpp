@@ -0,0 +1,134 @@
+#include "gamepad_mapping.hpp"
+
+namespace robikzinputtest {
+
+const GamepadMapping::AxisBindings GamepadMapping::UNBOUND_AXIS {};
+const GamepadMapping::HatBindings GamepadMapping::UNBOUND_HAT {};
+
+static GamepadControl gamepad_button_control(SDL_GamepadButton button) {
+	switch (button) {
+	case SDL_GAMEPAD_BUTTON_DPAD_UP:
+		return GamepadControl::DPAD_UP;
+	case SDL_GAMEPAD_BUTTON_DPAD_DOWN:
+		return GamepadControl::DPAD_DOWN;
+	case SDL_GAMEPAD_BUTTON_DPAD_LEFT:
+		return GamepadControl::DPAD_LEFT;
+	case SDL_GAMEPAD_BUTTON_DPAD_RIGHT:
+		return GamepadControl::DPAD_RIGHT;
+	case SDL_GAMEPAD_BUTTON_INVALID:
+		return GamepadControl::NONE;
+	default:
+		// Any other button triggers the action.
+		return GamepadControl::ACTION;
+	}
+}
+
+static GamepadControl gamepad_axis_control(SDL_GamepadAxis axis) {
+	switch (axis) {
+	case SDL_GAMEPAD_AXIS_LEFTX:
+		return GamepadControl::LEFT_STICK_X;
+	case SDL_GAMEPAD_AXIS_LEFTY:
+		return GamepadControl::LEFT_STICK_Y;
+	case SDL_GAMEPAD_AXIS_RIGHTX:
+		return GamepadControl::RIGHT_STICK_X;
+	case SDL_GAMEPAD_AXIS_RIGHTY:
+		return GamepadControl::RIGHT_STICK_Y;
+	case SDL_GAMEPAD_AXIS_LEFT_TRIGGER:
+		return GamepadControl::LEFT_TRIGGER;
+	case SDL_GAMEPAD_AXIS_RIGHT_TRIGGER:
+		return GamepadControl::RIGHT_TRIGGER;
+	default:
+		return GamepadControl::NONE;
+	}
+}
+
+int GamepadMapping::hat_direction_index(uint8_t hat_bit) {
+	switch (hat_bit) {
+	case SDL_HAT_UP:
+		return 0;
+	case SDL_HAT_RIGHT:
+		return 1;
+	case SDL_HAT_DOWN:
+		return 2;
+	case SDL_HAT_LEFT:
+		return 3;
+	default:
+		return -1;
+	}
+}
+
+GamepadMapping GamepadMapping::from_gamepad(SDL_Gamepad *gamepad) {
+	GamepadMapping mapping;
+	int num_bindings = 0;
+	SDL_GamepadBinding **bindings = SDL_GetGamepadBindings(gamepad, &num_bindings);
+	if (bindings == nullptr) {
+		return mapping;
+	}
+	for (int i = 0; i < num_bindings; ++i) {
+		const SDL_GamepadBinding &binding = *bindings[i];
+
+		GamepadControl control = GamepadControl::NONE;
+		int32_t output_min = 0;
+		int32_t output_max = 1;
+		if (binding.output_type == SDL_GAMEPAD_BINDTYPE_BUTTON) {
+			control = gamepad_button_control(binding.output.button);
+		} else if (binding.output_type == SDL_GAMEPAD_BINDTYPE_AXIS) {
+			control = gamepad_axis_control(binding.output.axis.axis);
+			output_min = binding.output.axis.axis_min;
+			output_max = binding.output.axis.axis_max;
+		}
+		if (control == GamepadControl::NONE) {
+			continue;
+		}
+
+		switch (binding.input_type) {
+		case SDL_GAMEPAD_BINDTYPE_AXIS: {
+			const int raw_axis = binding.input.axis.axis;
+			if (raw_axis < 0 || raw_axis >= MAX_AXES)
+				break;
+			for (GamepadAxisBinding &axis_binding : mapping.m_axes[raw_axis]) {
+				if (axis_binding.control != GamepadControl::NONE)
+					continue;
+				axis_binding.control = control;
+				axis_binding.input_min = binding.input.axis.axis_min;
+				axis_binding.input_max = binding.input.axis.axis_max;
+				axis_binding.output_min = output_min;
+				axis_binding.output_max = output_max;
+				const int32_t input_span = axis_binding.input_max - axis_binding.input_min;
+				axis_binding.scale = input_span != 0
+					? static_cast<float>(output_max - output_min) / static_cast<float>(input_span)
+					: 0.0f;
+				break;
+			}
+			break;
+		}
+		case SDL_GAMEPAD_BINDTYPE_BUTTON: {
+			const int raw_button = binding.input.button;
+			if (raw_button < 0 || raw_button >= MAX_BUTTONS)
+				break;
+			mapping.m_buttons[raw_button].control = control;
+			mapping.m_buttons[raw_button].analog_value = static_cast<int16_t>(
+				SDL_clamp(output_max, SDL_JOYSTICK_AXIS_MIN, SDL_JOYSTICK_AXIS_MAX)
+			);
+			break;
+		}
+		case SDL_GAMEPAD_BINDTYPE_HAT: {
+			const int raw_hat = binding.input.hat.hat;
+			if (raw_hat < 0 || raw_hat >= MAX_HATS)
+				break;
+			for (uint8_t hat_bit : { SDL_HAT_UP, SDL_HAT_RIGHT, SDL_HAT_DOWN, SDL_HAT_LEFT }) {
+				if (binding.input.hat.hat_mask & hat_bit) {
+					mapping.m_hats[raw_hat][hat_direction_index(hat_bit)] = control;
+				}
+			}
+			break;
+		}
+		default:
+			break;
+		}
+	}
+	SDL_free(bindings);
+	return mapping;
+}
+
+} // namespace robikzinputtest
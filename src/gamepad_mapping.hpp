@@ -0,0 +1,126 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+
+#include <array>
+#include <cstdint>
+
+namespace robikzinputtest {
+
+/**
+ * Logical control of a gamepad that the raw joystick controls map to.
+ */
+enum class GamepadControl : uint8_t {
+	NONE,
+	// Analog
+	LEFT_STICK_X,
+	LEFT_STICK_Y,
+	RIGHT_STICK_X,
+	RIGHT_STICK_Y,
+	LEFT_TRIGGER,
+	RIGHT_TRIGGER,
+	// Digital
+	DPAD_UP,
+	DPAD_DOWN,
+	DPAD_LEFT,
+	DPAD_RIGHT,
+	ACTION,
+};
+
+/// Number of the analog controls; they're the first in GamepadControl.
+static constexpr int GAMEPAD_ANALOG_CONTROL_COUNT = static_cast<int>(GamepadControl::RIGHT_TRIGGER) + 1;
+
+inline bool is_gamepad_analog_control(GamepadControl control) {
+	return control != GamepadControl::NONE
+		&& static_cast<int>(control) < GAMEPAD_ANALOG_CONTROL_COUNT;
+}
+
+/**
+ * Binding of a raw joystick axis range to a logical control.
+ *
+ * The ranges follow SDL_GamepadBinding: an axis may be split in halves
+ * and each half may drive a different control.
+ */
+struct GamepadAxisBinding {
+	GamepadControl control = GamepadControl::NONE;
+	int32_t input_min = 0;
+	int32_t input_max = 0;
+	int32_t output_min = 0;
+	int32_t output_max = 0;
+	/// Precomputed (output_max - output_min) / (input_max - input_min).
+	float scale = 1.0f;
+
+	bool in_range(int32_t value) const {
+		return input_min < input_max
+			? (value >= input_min && value <= input_max)
+			: (value >= input_max && value <= input_min);
+	}
+
+	/// Map the raw value to the output range. The value must be in range.
+	int32_t map(int32_t value) const {
+		return output_min + static_cast<int32_t>(static_cast<float>(value - input_min) * scale);
+	}
+
+	/// For digital controls: is the raw value past the half of the input range.
+	bool is_pressed(int32_t value) const {
+		const int32_t threshold = input_min + (input_max - input_min) / 2;
+		return input_min < input_max ? value >= threshold : value <= threshold;
+	}
+};
+
+/**
+ * Binding of a raw joystick button to a logical control.
+ */
+struct GamepadButtonBinding {
+	GamepadControl control = GamepadControl::NONE;
+	/// Value for an analog control when the button is pressed.
+	int16_t analog_value = SDL_JOYSTICK_AXIS_MAX;
+};
+
+/**
+ * Translation table from raw joystick controls to logical gamepad
+ * controls.
+ *
+ * The table is resolved once from SDL's gamepad mapping of the device,
+ * so the translation of an event is a single table lookup regardless
+ * of the device's layout.
+ */
+class GamepadMapping {
+public:
+	static constexpr int MAX_AXES = 16;
+	static constexpr int MAX_AXIS_BINDINGS = 2;
+	static constexpr int MAX_BUTTONS = 64;
+	static constexpr int MAX_HATS = 4;
+	static constexpr int HAT_DIRECTIONS = 4;
+
+	using AxisBindings = std::array<GamepadAxisBinding, MAX_AXIS_BINDINGS>;
+	using HatBindings = std::array<GamepadControl, HAT_DIRECTIONS>;
+
+	/// Resolve the table from the gamepad's current SDL mapping.
+	static GamepadMapping from_gamepad(SDL_Gamepad *gamepad);
+
+	const AxisBindings &axis(int raw_axis) const {
+		return (raw_axis >= 0 && raw_axis < MAX_AXES) ? m_axes[raw_axis] : UNBOUND_AXIS;
+	}
+
+	GamepadButtonBinding button(int raw_button) const {
+		return (raw_button >= 0 && raw_button < MAX_BUTTONS) ? m_buttons[raw_button] : GamepadButtonBinding {};
+	}
+
+	const HatBindings &hat(int raw_hat) const {
+		return (raw_hat >= 0 && raw_hat < MAX_HATS) ? m_hats[raw_hat] : UNBOUND_HAT;
+	}
+
+	/// Index into HatBindings for a single SDL_HAT_* direction bit.
+	static int hat_direction_index(uint8_t hat_bit);
+
+private:
+	static const AxisBindings UNBOUND_AXIS;
+	static const HatBindings UNBOUND_HAT;
+
+	std::array<AxisBindings, MAX_AXES> m_axes {};
+	std::array<GamepadButtonBinding, MAX_BUTTONS> m_buttons {};
+	std::array<HatBindings, MAX_HATS> m_hats {};
+};
+
+} // namespace robikzinputtest
@@ -3,6 +3,7 @@
 #include "controller.hpp"
 #include "clock.hpp"
 #include <SDL3/SDL.h>
+#include <bitset>
 #include <memory>
 #include <optional>
 
@@ -24,6 +25,8 @@ public:
 	// State
 	SDL_FPoint m_position;
 	std::optional<FrameTime> m_action_started_at;
+	/// Button channels of the controller that are down or got released this frame.
+	std::bitset<ControllerState::BUTTON_CHANNELS> m_active_buttons;
 
 	Gizmo();
 
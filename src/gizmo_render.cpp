@@ -6,6 +6,7 @@
 namespace robikzinputtest {
 
 static const float SDL_DEBUG_FONT_SIZE = SDL_DEBUG_TEXT_FONT_CHARACTER_SIZE;
+static const int BUTTON_CELLS_PER_ROW = 8;
 
 void GizmoRender::load_render(Renderer &renderer) {
 	// no-op
@@ -27,6 +28,24 @@ void GizmoRender::render(Renderer &renderer) {
 	SDL_SetRenderDrawColor(&renderer, frame_color.r, frame_color.g, frame_color.b, frame_color.a);
 	SDL_RenderRect(&renderer, &rect);
 
+	// Active button channels as a grid of cells in the lower half.
+	if (m_gizmo.m_active_buttons.any()) {
+		const int rows = (ControllerState::BUTTON_CHANNELS + BUTTON_CELLS_PER_ROW - 1) / BUTTON_CELLS_PER_ROW;
+		const SDL_FPoint cell = { size.x / BUTTON_CELLS_PER_ROW, size.y / 2 / rows };
+		SDL_SetRenderDrawColor(&renderer, m_button_color.r, m_button_color.g, m_button_color.b, m_button_color.a);
+		for (int channel = 0; channel < ControllerState::BUTTON_CHANNELS; ++channel) {
+			if (!m_gizmo.m_active_buttons.test(channel))
+				continue;
+			const SDL_FRect cell_rect = {
+				origin.x + (channel % BUTTON_CELLS_PER_ROW) * cell.x,
+				origin.y + size.y / 2 + (channel / BUTTON_CELLS_PER_ROW) * cell.y,
+				cell.x,
+				cell.y,
+			};
+			SDL_RenderFillRect(&renderer, &cell_rect);
+		}
+	}
+
 	SDL_FPoint original_scale;
 	SDL_GetRenderScale(&renderer, &original_scale.x, &original_scale.y);
 	const std::string gizmo_name = m_gizmo.name();
@@ -15,6 +15,7 @@ public:
 	SDL_Color m_frame_color = { 255, 96, 96, 255 };
 	SDL_Color m_active_color = { 0, 255, 0, 255 };
 	SDL_Color m_active_frame_color = { 96, 255, 96, 255 };
+	SDL_Color m_button_color = { 255, 255, 0, 255 };
 
 	GizmoRender(Gizmo &gizmo)
 		: m_gizmo(gizmo) {}
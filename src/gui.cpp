@@ -1,11 +1,16 @@
 #include "gui.hpp"
+#include "alloc_counter.hpp"
 #include "app.hpp"
+#include "frame_profiler.hpp"
 #include "logger.hpp"
 #include "gui_context.hpp"
 #include "gui_log.hpp"
 #include "gui_overlay_fps.hpp"
 #include "gui_overlay_help.hpp"
 #include "gui_overlay_joystick.hpp"
+#include "gui_overlay_keyboard.hpp"
+#include "gui_overlay_mouse.hpp"
+#include "gui_window_performance.hpp"
 #include "gui_window_program_log.hpp"
 #include "gui_window_settings.hpp"
 #include "sdl_event.hpp"
@@ -20,6 +25,11 @@ namespace robikzinputtest::gui {
 using namespace std::literals;
 
 static const auto DURATION_HELP_OVERLAY_SHOW = 5s;
+/**
+ * Full frames with the same content needed before it's cached; a window
+ * that appears takes a frame to fit its content.
+ */
+static const int CACHE_AFTER_STABLE_FRAMES = 2;
 
 static bool is_gui_demo_key(const SDL_KeyboardEvent &event) {
 	return (
@@ -39,6 +49,18 @@ static bool is_gui_settings_key(const SDL_KeyboardEvent &event) {
 	);
 }
 
+static bool is_gui_measurement_key(const SDL_KeyboardEvent &event) {
+	return (
+		event.type == SDL_EVENT_KEY_DOWN
+		&& event.key == SDLK_F7
+		&& !event.repeat
+	);
+}
+
+static bool is_gui_measurement_event(const SDL_Event &event) {
+	return is_gui_measurement_key(event.key);
+}
+
 static bool is_gui_settings_joystick_button(const SDL_JoyButtonEvent &event) {
 	return (
 		event.type == SDL_EVENT_JOYSTICK_BUTTON_DOWN
@@ -88,14 +110,36 @@ static bool is_imgui_swallowing_event(const SDL_Event &event) {
 		|| (sdl::is_mouse_event(event) && io.WantCaptureMouse);
 }
 
+/**
+ * Everything the cacheable GUI content depends on; while it's the same
+ * and no input arrived, the GUI looks the same.
+ */
+struct GuiContentKey {
+	SDL_Point window_size = { 0, 0 };
+	bool help = false;
+	bool fps = false;
+	double ms_per_frame = 0.0;
+	double frames_per_second = 0.0;
+
+	bool operator==(const GuiContentKey &other) const {
+		return window_size.x == other.window_size.x
+			&& window_size.y == other.window_size.y
+			&& help == other.help
+			&& fps == other.fps
+			&& ms_per_frame == other.ms_per_frame
+			&& frames_per_second == other.frames_per_second;
+	}
+};
+
 struct Gui::D {
 	App &app;
 	SDL_Window &window;
-	SDL_Renderer &renderer;
+	SDL_Renderer *renderer;
 
 	HandlerId log_handler_id = 0;
 	Log log;
 
+	std::unique_ptr<WindowPerformance> window_performance;
 	std::unique_ptr<WindowProgramLog> window_program_log;
 	std::unique_ptr<WindowSettings> window_settings;
 
@@ -105,8 +149,17 @@ struct Gui::D {
 
 	bool show_imgui_demo = false;
 	bool show_settings_window = false;
+	bool measurement_mode = false;
 
 	ExpirableValue<bool> show_help_overlay = { {}, false };
+	FpsReadout fps_readout;
+
+	// Draw data cache
+	/// ImGui took input since the last full frame.
+	bool gui_input = true;
+	GuiContentKey cached_key;
+	/// Consecutive full frames with the same content.
+	int stable_frames = 0;
 
 	D(
 		App &app,
@@ -114,7 +167,28 @@ struct Gui::D {
 		SDL_Renderer &renderer
 	) : app(app),
 		window(window),
-		renderer(renderer) {}
+		renderer(&renderer) {}
+
+	void invalidate_cache() {
+		gui_input = true;
+		stable_frames = 0;
+	}
+
+	/**
+	 * Only the help and FPS overlays are cached; the windows and the
+	 * other overlays show live data or animate.
+	 */
+	bool is_content_cacheable() const {
+		const Settings &settings = app.settings();
+		return !show_settings_window
+			&& !show_imgui_demo
+			&& !settings.show_program_log
+			&& !settings.show_performance_dashboard
+			&& !settings.show_joystick_info
+			&& !settings.show_mouse_info
+			&& !settings.show_keyboard_info
+			&& !settings.show_ui_frame_counter;
+	}
 };
 
 Gui::Gui(
@@ -136,6 +210,8 @@ bool Gui::init() {
 	);
 
 	IMGUI_CHECKVERSION();
+	// Count ImGui's allocations with the rest, for the allocations per frame.
+	ImGui::SetAllocatorFunctions(alloc_counter::allocate, alloc_counter::release);
 	d->imgui_init_context = ImGui::CreateContext() != nullptr;
 	if (!d->imgui_init_context)
 		return false;
@@ -145,11 +221,7 @@ bool Gui::init() {
 	io.ConfigFlags |= ImGuiConfigFlags_NavEnableGamepad;
 	io.IniFilename = nullptr; // disable spawn of imgui.ini
 
-	d->imgui_init_platform = ImGui_ImplSDL3_InitForSDLRenderer(&d->window, &d->renderer);
-	if (!d->imgui_init_platform)
-		return false;
-	d->imgui_init_renderer =  ImGui_ImplSDLRenderer3_Init(&d->renderer);
-	if (!d->imgui_init_renderer)
+	if (!attach_renderer(*d->renderer))
 		return false;
 
 	if (d->app.settings().show_help_at_start) {
@@ -161,6 +233,7 @@ bool Gui::init() {
 	d->show_settings_window = d->app.settings().show_settings_at_start;
 
 	d->window_settings = std::make_unique<WindowSettings>();
+	d->window_performance = std::make_unique<WindowPerformance>();
 	d->window_program_log = std::make_unique<WindowProgramLog>(d->log);
 
 	return true;
@@ -168,8 +241,17 @@ bool Gui::init() {
 
 void Gui::close() {
 	d->app.logger().on_logrecord.remove(d->log_handler_id);
+	d->window_performance.reset();
 	d->window_program_log.reset();
 	d->window_settings.reset();
+	release_renderer();
+	if (d->imgui_init_context) {
+		ImGui::DestroyContext();
+		d->imgui_init_context = false;
+	}
+}
+
+void Gui::release_renderer() {
 	if (d->imgui_init_renderer) {
 		ImGui_ImplSDLRenderer3_Shutdown();
 		d->imgui_init_renderer = false;
@@ -178,10 +260,18 @@ void Gui::close() {
 		ImGui_ImplSDL3_Shutdown();
 		d->imgui_init_platform = false;
 	}
-	if (d->imgui_init_context) {
-		ImGui::DestroyContext();
-		d->imgui_init_context = false;
-	}
+}
+
+bool Gui::attach_renderer(SDL_Renderer &renderer) {
+	release_renderer();
+	d->invalidate_cache();
+	d->renderer = &renderer;
+	d->imgui_init_platform = ImGui_ImplSDL3_InitForSDLRenderer(&d->window, d->renderer);
+	if (!d->imgui_init_platform)
+		return false;
+	// The textures, the font atlas too, are remade on the next frame.
+	d->imgui_init_renderer = ImGui_ImplSDLRenderer3_Init(d->renderer);
+	return d->imgui_init_renderer;
 }
 
 void Gui::clear_focus() {
@@ -200,12 +290,38 @@ void Gui::set_demo_enabled(bool enabled) {
 	d->show_imgui_demo = enabled;
 }
 
+bool Gui::is_measurement_mode() const {
+	return d->measurement_mode;
+}
+
+void Gui::set_measurement_mode(bool enabled) {
+	if (enabled == d->measurement_mode) {
+		return;
+	}
+	d->measurement_mode = enabled;
+	d->invalidate_cache();
+	d->app.logger().info() << (enabled ? "Entered" : "Left") << " the measurement mode" << std::endl;
+}
+
 bool Gui::handle_event(SDL_Event &event) {
+	if (is_gui_measurement_event(event)) {
+		set_measurement_mode(!d->measurement_mode);
+		return true;
+	}
+	if (d->measurement_mode) {
+		// Without frames, ImGui can't take the input; the GUI keys bring it back.
+		if (!is_gui_settings_event(event) && !is_gui_demo_event(event)) {
+			return false;
+		}
+		set_measurement_mode(false);
+	}
+
 	if (
 		is_gui_focus_event(event)
 		&& !is_imgui_swallowing_event(event)
 	) {
 		grab_focus();
+		d->invalidate_cache();
 		return true;
 	}
 
@@ -214,52 +330,92 @@ bool Gui::handle_event(SDL_Event &event) {
 		&& is_imgui_swallowing_event(event)
 	) {
 		clear_focus();
+		d->invalidate_cache();
 		return true;
 	}
 
 	if (is_gui_demo_event(event)) {
 		d->show_imgui_demo = !d->show_imgui_demo;
+		d->invalidate_cache();
 		return true;
 	} else if (is_gui_settings_event(event)) {
 		d->show_settings_window = !d->show_settings_window;
+		d->invalidate_cache();
 		return true;
 	}
 
-	ImGui_ImplSDL3_ProcessEvent(&event);
+	if (ImGui_ImplSDL3_ProcessEvent(&event)) {
+		d->gui_input = true;
+	}
 	return is_imgui_swallowing_event(event);
 }
 
-void Gui::iterate(
+GuiFrame Gui::iterate(
 	const FrameTime &frame_time
 ) {
 	GuiContext guictx = { d->app, frame_time };
 	SDL_GetWindowSize(&d->window, &guictx.window_size.x, &guictx.window_size.y);
 
-	ImGuiIO &imgui_io = ImGui::GetIO();
+	d->fps_readout.update(frame_time.delta_seconds);
+	if (
+		d->show_help_overlay
+		&& !d->app.settings().show_help
+		&& d->show_help_overlay.countdown(frame_time.delta_seconds)
+	) {
+		d->show_help_overlay.value = false;
+	}
+	const bool show_help = d->show_help_overlay || d->app.settings().show_help;
+
+	if (d->measurement_mode) {
+		return GuiFrame::SKIPPED;
+	}
+
+	// Nothing changed: draw the previous frame again, which stays valid
+	// until the next ImGui::NewFrame().
+	const GuiContentKey key = {
+		guictx.window_size,
+		show_help,
+		d->app.settings().show_fps,
+		d->fps_readout.ms_per_frame,
+		d->fps_readout.fps,
+	};
+	const bool cacheable = d->is_content_cacheable();
+	if (
+		cacheable
+		&& !d->gui_input
+		&& d->stable_frames >= CACHE_AFTER_STABLE_FRAMES
+		&& key == d->cached_key
+	) {
+		ImGui_ImplSDLRenderer3_RenderDrawData(ImGui::GetDrawData(), d->renderer);
+		return GuiFrame::CACHED;
+	}
+
 	ImGui_ImplSDLRenderer3_NewFrame();
 	ImGui_ImplSDL3_NewFrame();
 	ImGui::NewFrame();
 
 	// Overlays
-	if (d->show_help_overlay || d->app.settings().show_help) {
-		if (
-			!d->app.settings().show_help &&
-			d->show_help_overlay.countdown(frame_time.delta_seconds)
-		) {
-			d->show_help_overlay.value = false;
-		} else {
-			overlay_help(guictx);
-		}
+	if (show_help) {
+		overlay_help(guictx);
 	}
-	overlay_fps(guictx);
+	overlay_fps(guictx, d->fps_readout);
 	if (d->app.settings().show_joystick_info) {
 		overlay_joystick(guictx);
 	}
+	if (d->app.settings().show_mouse_info) {
+		overlay_mouse(guictx);
+	}
+	if (d->app.settings().show_keyboard_info) {
+		overlay_keyboard(guictx);
+	}
 
 	// Windows
 	if (d->app.settings().show_program_log) {
 		d->window_program_log->draw(guictx);
 	}
+	if (d->app.settings().show_performance_dashboard) {
+		d->window_performance->draw(guictx, &d->app.settings().show_performance_dashboard);
+	}
 	if (d->show_settings_window) {
 		d->window_settings->draw(guictx, &d->show_settings_window);
 	}
@@ -269,7 +425,13 @@ void Gui::iterate(
 
 	ImGui::Render();
 
-	ImGui_ImplSDLRenderer3_RenderDrawData(ImGui::GetDrawData(), &d->renderer);
+	ImGui_ImplSDLRenderer3_RenderDrawData(ImGui::GetDrawData(), d->renderer);
+
+	const bool stable = cacheable && !d->gui_input && key == d->cached_key;
+	d->stable_frames = stable ? d->stable_frames + 1 : 0;
+	d->cached_key = key;
+	d->gui_input = false;
+	return GuiFrame::FULL;
 }
 
 } // namespace robikzinputtest::gui
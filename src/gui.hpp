@@ -7,6 +7,7 @@ namespace robikzinputtest {
 
 class App;
 struct FrameTime;
+enum class GuiFrame;
 
 namespace gui {
 
@@ -18,14 +19,26 @@ public:
 	bool init();
 	void close();
 
+	/// Let go of the renderer, before it's destroyed.
+	void release_renderer();
+	/// Draw with another renderer, e.g. of another render driver.
+	bool attach_renderer(SDL_Renderer &renderer);
+
 	void clear_focus();
 	void grab_focus();
 
 	bool is_demo_enabled() const;
 	void set_demo_enabled(bool enabled);
+	/// ImGui is skipped altogether and takes no input; F7 toggles it.
+	bool is_measurement_mode() const;
+	void set_measurement_mode(bool enabled);
 
 	bool handle_event(SDL_Event &event);
-	void iterate(const FrameTime &frame_time);
+	/**
+	 * Build and draw the GUI. When nothing could have changed since
+	 * the last frames, the previous draw data is drawn again instead.
+	 */
+	GuiFrame iterate(const FrameTime &frame_time);
 
 private:
 	struct D;
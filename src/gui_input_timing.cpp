@@ -0,0 +1,117 @@
+#include "gui_input_timing.hpp"
+
+#include "controller.hpp"
+#include "input_timing.hpp"
+#include "sensor_capture.hpp"
+
+#include <imgui.h>
+
+#include <cstdio>
+
+namespace robikzinputtest::gui {
+
+static void polling_rate_text(const PollingRateAnalyzer &analyzer) {
+	const PollingRateReport report = analyzer.report();
+	if (report.rate_hz <= 0.0) {
+		ImGui::Text("Report Rate: - (%llu reports)", static_cast<unsigned long long>(report.reports));
+		return;
+	}
+	ImGui::Text(
+		"Report Rate: %.1f Hz (mean %.1f Hz)",
+		report.rate_hz,
+		report.mean_rate_hz
+	);
+	ImGui::Text(
+		"Interval ms: min %.3f p50 %.3f p90 %.3f p99 %.3f max %.3f",
+		report.interval_min_us / 1000.0,
+		report.interval_p50_us / 1000.0,
+		report.interval_p90_us / 1000.0,
+		report.interval_p99_us / 1000.0,
+		report.interval_max_us / 1000.0
+	);
+	ImGui::Text("Jitter: %.3f ms", report.jitter_us / 1000.0);
+	ImGui::Text(
+		"Reports: %llu, missing: %llu, duplicate: %llu",
+		static_cast<unsigned long long>(report.reports),
+		static_cast<unsigned long long>(report.missing),
+		static_cast<unsigned long long>(report.duplicates)
+	);
+}
+
+static void latency_text(const LatencyTracker &tracker) {
+	const LatencyReport report = tracker.report();
+	if (report.frames == 0) {
+		ImGui::Text("Input to Present: -");
+		return;
+	}
+	ImGui::Text(
+		"Input to Present ms: last %.3f p50 %.3f p90 %.3f p99 %.3f max %.3f",
+		report.last_us / 1000.0,
+		report.p50_us / 1000.0,
+		report.p90_us / 1000.0,
+		report.p99_us / 1000.0,
+		report.max_us / 1000.0
+	);
+}
+
+void input_timing_text(const InputTiming &timing) {
+	polling_rate_text(timing.polling_rate);
+	latency_text(timing.latency);
+}
+
+static void sensor_stream_text(const char *name, const char *unit, const SensorStream &stream) {
+	if (stream.samples.empty()) {
+		return;
+	}
+	const SensorSample &sample = stream.samples.back();
+	ImGui::Text(
+		"%s %s: %+.3f %+.3f %+.3f",
+		name,
+		unit,
+		sample.data[0],
+		sample.data[1],
+		sample.data[2]
+	);
+	const PollingRateReport native = stream.native_rate.report();
+	const PollingRateReport delivery = stream.delivery_rate.report();
+	ImGui::Text(
+		"%s Rate: %.1f Hz native, %.1f Hz delivered, jitter %.3f ms",
+		name,
+		native.rate_hz,
+		delivery.mean_rate_hz,
+		delivery.jitter_us / 1000.0
+	);
+	latency_text(stream.latency);
+}
+
+void sensor_capture_text(const SensorCapture &sensors) {
+	sensor_stream_text("Gyro", "rad/s", sensors.gyro);
+	sensor_stream_text("Accel", "m/s2", sensors.accel);
+}
+
+void button_latency_text(const Controller &controller) {
+	for (int channel = 0; channel < ControllerState::BUTTON_CHANNELS; ++channel) {
+		const LatencyReport report = controller.button_latency(channel).report();
+		if (report.frames == 0)
+			continue;
+		char label[16];
+		if (channel == ControllerState::LEFT_THROTTLE_CHANNEL) {
+			std::snprintf(label, sizeof(label), "L Trigger");
+		} else if (channel == ControllerState::RIGHT_THROTTLE_CHANNEL) {
+			std::snprintf(label, sizeof(label), "R Trigger");
+		} else {
+			std::snprintf(label, sizeof(label), "Button %d", channel);
+		}
+		ImGui::Text(
+			"%s%s: %llu presses, ms p50 %.3f p99 %.3f max %.3f",
+			label,
+			controller.state.is_button_down(channel) ? "*" : "",
+			static_cast<unsigned long long>(report.frames),
+			report.p50_us / 1000.0,
+			report.p99_us / 1000.0,
+			report.max_us / 1000.0
+		);
+	}
+}
+
+} // namespace robikzinputtest::gui
@@ -0,0 +1,20 @@
+#pragma once
+
+namespace robikzinputtest {
+class Controller;
+struct InputTiming;
+struct SensorCapture;
+}
+
+namespace robikzinputtest::gui {
+
+/// Text lines with the polling rate and latency of an input device.
+void input_timing_text(const InputTiming &timing);
+
+/// Text lines with the press-to-present latency of each button that was pressed.
+void button_latency_text(const Controller &controller);
+
+/// Text lines with the latest sample, sample rate and latency of each sensor.
+void sensor_capture_text(const SensorCapture &sensors);
+
+} // namespace robikzinputtest::gui
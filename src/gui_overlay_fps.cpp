@@ -9,7 +9,20 @@
 
 namespace robikzinputtest::gui {
 
-void overlay_fps(const GuiContext &guictx) {
+bool FpsReadout::update(double delta_seconds) {
+	m_elapsed_seconds += delta_seconds;
+	++m_frames;
+	if (m_elapsed_seconds < INTERVAL_SECONDS) {
+		return false;
+	}
+	ms_per_frame = 1000.0 * m_elapsed_seconds / m_frames;
+	fps = m_frames / m_elapsed_seconds;
+	m_elapsed_seconds = 0.0;
+	m_frames = 0;
+	return true;
+}
+
+void overlay_fps(const GuiContext &guictx, const FpsReadout &readout) {
 	const bool show_fps = guictx.app.settings().show_fps;
 	const bool show_ui_frame_counter = guictx.app.settings().show_ui_frame_counter;
 
@@ -20,7 +33,6 @@ void overlay_fps(const GuiContext &guictx) {
 		return;
 	}
 
-	ImGuiIO &imgui_io = ImGui::GetIO();
 	ImGui::SetNextWindowPos(
 		{ static_cast<float>(guictx.window_size.x), 0 },
 		0,
@@ -31,8 +43,8 @@ void overlay_fps(const GuiContext &guictx) {
 	if (show_fps) {
 		ImGui::Text(
 			"%.3f ms/frame (%.1f FPS)",
-			1000.0f / imgui_io.Framerate,
-			imgui_io.Framerate
+			readout.ms_per_frame,
+			readout.fps
 		);
 	}
 	if (show_ui_frame_counter) {
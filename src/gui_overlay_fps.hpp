@@ -4,6 +4,27 @@ namespace robikzinputtest::gui {
 
 struct GuiContext;
 
-void overlay_fps(const GuiContext &guictx);
+/**
+ * The frame rate shown by the overlay, averaged over a short interval.
+ *
+ * It's measured on the app's frame times rather than ImGui's, which
+ * only advance when the GUI builds a new frame, and it changes only
+ * a few times a second, so that the overlay can be cached in-between.
+ */
+struct FpsReadout {
+	static constexpr double INTERVAL_SECONDS = 0.25;
+
+	double ms_per_frame = 0.0;
+	double fps = 0.0;
+
+	/// Count the frame; returns true if the shown values changed.
+	bool update(double delta_seconds);
+
+private:
+	double m_elapsed_seconds = 0.0;
+	int m_frames = 0;
+};
+
+void overlay_fps(const GuiContext &guictx, const FpsReadout &readout);
 
 } // namespace robikzinputtest::gui
@@ -13,8 +13,11 @@ void overlay_help(const GuiContext &guictx) {
 	ImGui::Begin("HELP Overlay", nullptr, imgui::overlay_flags);
 	ImGui::Text(
 		"Press F5 or START to open settings\n"
+		"Press F6 to switch to the next settings profile\n"
+		"Press F7 to turn the GUI off for measurements, and back on\n"
 		"Press ENTER or SPACE to spawn keyboard Gizmo\n"
 		"Press any button on controller to spawn controller Gizmo\n"
+		"Click the mouse to spawn mouse Gizmo, press ESC to release it\n"
 		"Press CTRL+Q to quit\n"
 	);
 	ImGui::End();
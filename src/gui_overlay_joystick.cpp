@@ -1,17 +1,66 @@
 #include "gui_overlay_joystick.hpp"
 
-#include "SDL3/SDL_joystick.h"
 #include "app.hpp"
+#include "axis_noise.hpp"
+#include "controller_system.hpp"
 #include "gui_context.hpp"
+#include "gui_input_timing.hpp"
 #include "imgui_defs.hpp"
+#include "input_timing.hpp"
+#include "joystick_snapshot.hpp"
+#include "sensor_capture.hpp"
 #include "settings.hpp"
 
 #include <imgui.h>
 
+#include <cstdio>
+
 namespace robikzinputtest::gui {
 
+static const ImVec2 AXIS_SPARKLINE_SIZE = { 128.0f, 20.0f };
+
+static void axis_sparkline(const JoystickSnapshot &snapshot, int axis) {
+	const JoystickSnapshot::AxisHistory &history = snapshot.axis_history[axis];
+	char value_text[16];
+	std::snprintf(value_text, sizeof(value_text), "%d", snapshot.axes[axis]);
+	ImGui::PushID(axis);
+	ImGui::PlotLines(
+		"##history",
+		history.data(),
+		static_cast<int>(history.size()),
+		static_cast<int>(history.offset()),
+		value_text,
+		-1.0f, 1.0f,
+		AXIS_SPARKLINE_SIZE
+	);
+	ImGui::PopID();
+	ImGui::SameLine();
+	ImGui::Text("Axis %d", axis);
+}
+
+static void axis_noise_text(const AxisNoiseStats &stats, int axis) {
+	ImGui::Text(
+		"  Axis %d: [%d, %d] %u values (%.1f bits)",
+		axis,
+		stats.min,
+		stats.max,
+		stats.distinct,
+		stats.resolution_bits()
+	);
+	if (stats.rest.count > 0) {
+		ImGui::SameLine();
+		ImGui::Text(
+			"rest %+.1f (now %+.1f) noise %.1f [%+d, %+d]",
+			stats.rest.mean,
+			stats.rest_recent,
+			stats.rest.stddev(),
+			stats.rest_min,
+			stats.rest_max
+		);
+	}
+}
+
 void overlay_joystick(const GuiContext &guictx) {
-	ImGuiIO &imgui_io = ImGui::GetIO();
 	ImGui::SetNextWindowPos(
 		{ static_cast<float>(guictx.window_size.x), 60.0f },
 		0,
@@ -19,39 +68,52 @@ void overlay_joystick(const GuiContext &guictx) {
 	);
 	ImGui::SetNextWindowSize({ 0, 0 }, ImGuiCond_Always);
 	ImGui::Begin("Joystick Overlay", nullptr, imgui::overlay_flags);
-	const OpenedJoysticksMap &joysticks = guictx.app.joysticks();
-	ImGui::Text("Joystick Count: %zu", joysticks.size());
+	const JoystickSnapshotMap &snapshots = guictx.app.joystick_snapshots();
+	const JoystickTimingMap &joystick_timing = guictx.app.joystick_timing();
+	const JoystickAxisNoiseMap &joystick_axis_noise = guictx.app.joystick_axis_noise();
+	const JoystickSensorMap &joystick_sensors = guictx.app.joystick_sensors();
+	ImGui::Text("Joystick Count: %zu", snapshots.size());
 	ImGui::Text("Joystick Deadzone: %d", guictx.app.settings().joystick_deadzone);
-	SDL_LockJoysticks();
-	for (const auto &joypair : joysticks) {
-		auto joy_id = joypair.first;
-		auto joystick = joypair.second.get();
-
-		std::ostringstream ss_title;
-		ss_title << "Joystick " << joy_id;
-		ImGui::SeparatorText(ss_title.str().c_str());
-
-		const int n_axes = SDL_GetNumJoystickAxes(joystick);
-		for (int axis = 0; axis < n_axes; ++axis) {
-			const int axis_value = SDL_GetJoystickAxis(joystick, axis);
-			ImGui::Text("Axis %d: %d", axis, axis_value);
+	for (const auto &snappair : snapshots) {
+		const JoystickSnapshot &snapshot = snappair.second;
+		ImGui::PushID(static_cast<int>(snappair.first));
+		ImGui::SeparatorText(snapshot.title);
+
+		for (int axis = 0; axis < snapshot.n_axes; ++axis) {
+			axis_sparkline(snapshot, axis);
 		}
-		const int n_hats = SDL_GetNumJoystickHats(joystick);
-		for (int hat = 0; hat < n_hats; ++hat) {
-			const int hat_value = SDL_GetJoystickHat(joystick, hat);
-			ImGui::Text("Hat %d: %d", hat, hat_value);
+		for (int hat = 0; hat < snapshot.n_hats; ++hat) {
+			ImGui::Text("Hat %d: %d", hat, snapshot.hats[hat]);
 		}
-		const int n_buttons = SDL_GetNumJoystickButtons(joystick);
-		std::ostringstream ss_buttons;
-		for (int button = 0; button < n_buttons; ++button) {
-			const bool down = SDL_GetJoystickButton(joystick, button);
-			if (down) {
-				ss_buttons << button << " ";
+		ImGui::Text("Buttons: %s", snapshot.buttons_text);
+
+		auto axis_noise = joystick_axis_noise.find(snappair.first);
+		if (axis_noise != joystick_axis_noise.end()) {
+			const AxisNoiseAnalyzer &analyzer = axis_noise->second;
+			for (int axis = 0; axis < analyzer.n_axes(); ++axis) {
+				axis_noise_text(analyzer.axis(axis), axis);
+			}
+			const int32_t deadzone = analyzer.suggested_deadzone();
+			if (deadzone > 0) {
+				ImGui::Text("Suggested Deadzone: %d", deadzone);
+			} else {
+				ImGui::Text("Suggested Deadzone: - (leave the sticks at rest)");
 			}
 		}
-		ImGui::Text("Buttons: %s", ss_buttons.str().c_str());
+
+		auto timing = joystick_timing.find(snappair.first);
+		if (timing != joystick_timing.end()) {
+			input_timing_text(timing->second);
+		}
+		auto sensors = joystick_sensors.find(snappair.first);
+		if (sensors != joystick_sensors.end()) {
+			sensor_capture_text(sensors->second);
+		}
+		if (const Controller *controller = guictx.app.controller_system().find_joystick(snappair.first)) {
+			button_latency_text(*controller);
+		}
+		ImGui::PopID();
 	}
-	SDL_UnlockJoysticks();
 	ImGui::End();
 }
 
@@ -0,0 +1,81 @@
+#include "gui_overlay_keyboard.hpp"
+
+#include "app.hpp"
+#include "controller_system.hpp"
+#include "gui_context.hpp"
+#include "gui_input_timing.hpp"
+#include "imgui_defs.hpp"
+#include "keyboard_state.hpp"
+
+#include <imgui.h>
+
+namespace robikzinputtest::gui {
+
+void overlay_keyboard(const GuiContext &guictx) {
+	ImGui::SetNextWindowPos(
+		{ 0, static_cast<float>(guictx.window_size.y) },
+		0,
+		{ 0, 1.0 }
+	);
+	ImGui::SetNextWindowSize({ 0, 0 }, ImGuiCond_Always);
+	ImGui::Begin("Keyboard Overlay", nullptr, imgui::overlay_flags);
+	const KeyboardAnalyzer &analyzer = guictx.app.keyboard_analyzer();
+	const KeyboardState &state = analyzer.state();
+
+	ImGui::Text(
+		"Keys Held: %zu (max at once: %zu)",
+		state.count(),
+		analyzer.max_rollover()
+	);
+	ImGui::TextUnformatted("Held:");
+	for (int scancode = 0; scancode < SDL_SCANCODE_COUNT; ++scancode) {
+		if (state.is_down(static_cast<SDL_Scancode>(scancode))) {
+			ImGui::SameLine();
+			ImGui::TextUnformatted(SDL_GetScancodeName(static_cast<SDL_Scancode>(scancode)));
+		}
+	}
+
+	ImGui::Text(
+		"Presses: %llu, chatter: %llu",
+		static_cast<unsigned long long>(analyzer.presses()),
+		static_cast<unsigned long long>(analyzer.chatter())
+	);
+	const Histogram &hold_times = analyzer.hold_times();
+	if (hold_times.count() > 0) {
+		ImGui::Text(
+			"Hold ms: min %.3f p50 %.3f p99 %.3f",
+			hold_times.min() / 1000.0,
+			hold_times.percentile(0.50) / 1000.0,
+			hold_times.percentile(0.99) / 1000.0
+		);
+	}
+
+	if (const Controller *controller = guictx.app.controller_system().find_keyboard()) {
+		button_latency_text(*controller);
+	}
+
+	// List the first few keys that chatter.
+	static const int CHATTERING_KEYS_SHOWN = 5;
+	int shown = 0;
+	for (int scancode = 0; scancode < SDL_SCANCODE_COUNT && shown < CHATTERING_KEYS_SHOWN; ++scancode) {
+		const KeyPressStats &stats = analyzer.key(static_cast<SDL_Scancode>(scancode));
+		if (stats.chatter == 0) {
+			continue;
+		}
+		if (shown == 0) {
+			ImGui::SeparatorText("Chattering Keys");
+		}
+		ImGui::Text(
+			"%s: %u of %u presses, min gap %.3f ms, min hold %.3f ms",
+			SDL_GetScancodeName(static_cast<SDL_Scancode>(scancode)),
+			stats.chatter,
+			stats.presses,
+			stats.min_gap_ns / 1e6,
+			stats.min_hold_ns / 1e6
+		);
+		++shown;
+	}
+	ImGui::End();
+}
+
+} // namespace robikzinputtest::gui
@@ -0,0 +1,9 @@
+#pragma once
+
+namespace robikzinputtest::gui {
+
+struct GuiContext;
+
+void overlay_keyboard(const GuiContext &guictx);
+
+} // namespace robikzinputtest::gui
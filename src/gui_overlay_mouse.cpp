@@ -0,0 +1,42 @@
+#include "gui_overlay_mouse.hpp"
+
+#include "app.hpp"
+#include "controller_system.hpp"
+#include "gui_context.hpp"
+#include "gui_input_timing.hpp"
+#include "imgui_defs.hpp"
+#include "input_timing.hpp"
+
+#include <imgui.h>
+
+#include <sstream>
+
+namespace robikzinputtest::gui {
+
+void overlay_mouse(const GuiContext &guictx) {
+	ImGui::SetNextWindowPos(
+		{ static_cast<float>(guictx.window_size.x), static_cast<float>(guictx.window_size.y) },
+		0,
+		{ 1.0, 1.0 }
+	);
+	ImGui::SetNextWindowSize({ 0, 0 }, ImGuiCond_Always);
+	ImGui::Begin("Mouse Overlay", nullptr, imgui::overlay_flags);
+	const MouseTimingMap &mice = guictx.app.mouse_timing();
+	ImGui::Text("Mouse Count: %zu", mice.size());
+	ImGui::Text(
+		"Mouse Captured: %s (ESC releases)",
+		SDL_GetWindowRelativeMouseMode(guictx.app.window()) ? "yes" : "no"
+	);
+	for (const auto &mousepair : mice) {
+		std::ostringstream ss_title;
+		ss_title << "Mouse " << mousepair.first;
+		ImGui::SeparatorText(ss_title.str().c_str());
+		input_timing_text(mousepair.second);
+		if (const Controller *controller = guictx.app.controller_system().find_mouse(mousepair.first)) {
+			button_latency_text(*controller);
+		}
+	}
+	ImGui::End();
+}
+
+} // namespace robikzinputtest::gui
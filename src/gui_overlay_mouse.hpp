@@ -0,0 +1,9 @@
+#pragma once
+
+namespace robikzinputtest::gui {
+
+struct GuiContext;
+
+void overlay_mouse(const GuiContext &guictx);
+
+} // namespace robikzinputtest::gui
@@ -0,0 +1,186 @@
+#include "gui_window_performance.hpp"
+
+#include "app.hpp"
+#include "csv.hpp"
+#include "event_rate_monitor.hpp"
+#include "frame_profiler.hpp"
+#include "gui_context.hpp"
+#include "logger.hpp"
+
+#include <SDL3/SDL.h>
+#include <imgui.h>
+
+#include <algorithm>
+#include <cfloat>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace robikzinputtest::gui {
+
+static const ImVec2 PLOT_SIZE = { 0.0f, 48.0f };
+static const int MIN_SHOWN_SAMPLES = 16;
+static const float MAX_SCALE_MS = 100.0f;
+
+using History = FrameProfiler::History;
+
+/// The newest samples of a history, as handed to ImGui::PlotLines().
+struct PlotWindow {
+	const History *history;
+	size_t first;
+};
+
+static float plot_window_sample(void *data, int idx) {
+	const auto &window = *static_cast<const PlotWindow *>(data);
+	return (*window.history)[window.first + idx];
+}
+
+/// Plot the newest shown samples; a zero scale fits the plot to them.
+static void plot(const char *label, const char *unit, const History &history, int shown, float scale) {
+	const size_t count = std::min(history.size(), static_cast<size_t>(shown));
+	PlotWindow window { &history, history.size() - count };
+	float max = 0.0f;
+	for (size_t i = 0; i < count; ++i) {
+		max = std::max(max, history[window.first + i]);
+	}
+	char overlay[64] = "";
+	if (count > 0) {
+		std::snprintf(overlay, sizeof(overlay), "%.2f %s, max %.2f", history.back(), unit, max);
+	}
+	ImGui::PlotLines(
+		label,
+		plot_window_sample,
+		&window,
+		static_cast<int>(count),
+		0,
+		overlay,
+		0.0f,
+		scale > 0.0f ? scale : FLT_MAX,
+		PLOT_SIZE
+	);
+}
+
+static void write_series(std::ostream &out, const char *series, const History &history) {
+	for (size_t i = 0; i < history.size(); ++i) {
+		write_csv_text(out, series);
+		out << ',' << i << ',' << history[i] << '\n';
+	}
+}
+
+/// File name stamped with the local time, to not overwrite earlier exports.
+static std::string export_file_name() {
+	SDL_Time now = 0;
+	SDL_DateTime date {};
+	if (!SDL_GetCurrentTime(&now) || !SDL_TimeToDateTime(now, &date, true)) {
+		return "performance.csv";
+	}
+	char name[64];
+	std::snprintf(
+		name, sizeof(name), "performance-%04d%02d%02d-%02d%02d%02d.csv",
+		date.year, date.month, date.day, date.hour, date.minute, date.second
+	);
+	return name;
+}
+
+struct WindowPerformance::D {
+	bool paused = false;
+	/// What's shown while paused.
+	FrameProfiler frozen_profiler;
+	std::vector<DeviceEventRate> frozen_devices;
+
+	/// Zoom: how many of the newest samples the plots show.
+	int shown_samples = static_cast<int>(FrameProfiler::HISTORY);
+	/// Top of the plots in ms; 0 fits them to the samples.
+	float scale_ms = 0.0f;
+
+	void export_csv(
+		Logger &logger,
+		const FrameProfiler &profiler,
+		const std::vector<DeviceEventRate> &devices
+	) const {
+		const std::string path = export_file_name();
+		std::ofstream out(path);
+		out << "series,sample,value\n";
+		write_series(out, "frame_ms", profiler.frame_intervals());
+		for (size_t i = 0; i < FrameProfiler::PHASE_COUNT; ++i) {
+			const FramePhase phase = static_cast<FramePhase>(i);
+			write_series(out, (std::string(frame_phase_label(phase)) + "_ms").c_str(), profiler.history(phase));
+		}
+		write_series(out, "latency_ms", profiler.latencies());
+		write_series(out, "allocations", profiler.allocations());
+		for (const DeviceEventRate &device : devices) {
+			write_series(out, (device.label + " events_per_s").c_str(), device.rates);
+		}
+		out.close();
+		if (!out) {
+			logger.error() << "Failed to export the performance data to " << path << std::endl;
+			return;
+		}
+		logger.info() << "Exported the performance data to " << path << std::endl;
+	}
+};
+
+WindowPerformance::WindowPerformance() : d(std::make_unique<D>()) {}
+
+WindowPerformance::~WindowPerformance() = default;
+
+void WindowPerformance::draw(const GuiContext &guictx, bool *p_open) {
+	ImGui::SetNextWindowSize({ 420.0f, 0.0f }, ImGuiCond_FirstUseEver);
+	if (!ImGui::Begin("Performance", p_open)) {
+		ImGui::End();
+		return;
+	}
+
+	if (ImGui::Checkbox("Pause", &d->paused) && d->paused) {
+		d->frozen_profiler = guictx.app.frame_profiler();
+		d->frozen_devices = guictx.app.event_rates().devices();
+	}
+	const FrameProfiler &profiler = d->paused ? d->frozen_profiler : guictx.app.frame_profiler();
+	const std::vector<DeviceEventRate> &devices = d->paused
+		? d->frozen_devices
+		: guictx.app.event_rates().devices();
+	ImGui::SameLine();
+	if (ImGui::Button("Export CSV")) {
+		d->export_csv(guictx.app.logger(), profiler, devices);
+	}
+	ImGui::SetNextItemWidth(150.0f);
+	ImGui::SliderInt(
+		"Samples", &d->shown_samples,
+		MIN_SHOWN_SAMPLES, static_cast<int>(FrameProfiler::HISTORY),
+		"%d", ImGuiSliderFlags_AlwaysClamp
+	);
+	ImGui::SameLine();
+	ImGui::SetNextItemWidth(100.0f);
+	ImGui::SliderFloat(
+		"Scale", &d->scale_ms, 0.0f, MAX_SCALE_MS,
+		d->scale_ms > 0.0f ? "%.1f ms" : "Auto", ImGuiSliderFlags_AlwaysClamp
+	);
+
+	const int shown = d->shown_samples;
+	const float scale = d->scale_ms;
+	ImGui::SeparatorText("Frame");
+	plot("Frame time", "ms", profiler.frame_intervals(), shown, scale);
+	plot("Present", "ms", profiler.history(FramePhase::PRESENT), shown, scale);
+	plot("Input latency", "ms", profiler.latencies(), shown, scale);
+	plot("Allocations", "", profiler.allocations(), shown, 0.0f);
+
+	if (ImGui::CollapsingHeader("Phases", ImGuiTreeNodeFlags_DefaultOpen)) {
+		for (size_t i = 0; i < FrameProfiler::PHASE_COUNT; ++i) {
+			const FramePhase phase = static_cast<FramePhase>(i);
+			plot(frame_phase_label(phase), "ms", profiler.history(phase), shown, scale);
+		}
+	}
+
+	if (ImGui::CollapsingHeader("Events per second", ImGuiTreeNodeFlags_DefaultOpen)) {
+		if (devices.empty()) {
+			ImGui::TextDisabled("No input events yet");
+		}
+		for (const DeviceEventRate &device : devices) {
+			plot(device.label.c_str(), "/s", device.rates, shown, 0.0f);
+		}
+	}
+	ImGui::End();
+}
+
+} // namespace robikzinputtest::gui
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <memory>
+
+namespace robikzinputtest::gui {
+
+struct GuiContext;
+
+/**
+ * Live plots of what the frames cost: the frame time, its phases,
+ * the input event rates, the input-to-present latency, the present
+ * blocking time and the heap allocations.
+ */
+class WindowPerformance {
+public:
+	WindowPerformance();
+	~WindowPerformance();
+
+	void draw(const GuiContext &guictx, bool *p_open = nullptr);
+
+private:
+	struct D;
+	std::unique_ptr<D> d;
+};
+
+} // namespace robikzinputtest::gui
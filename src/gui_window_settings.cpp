@@ -2,11 +2,16 @@
 
 #include "app.hpp"
 #include "arena.hpp"
+#include "axis_response.hpp"
+#include "display_registry.hpp"
+#include "frame_pacer.hpp"
 #include "gui_context.hpp"
 #include "gui_window_about.hpp"
 #include "gui_window_resolution_popup.hpp"
 #include "logger.hpp"
+#include "present_timing.hpp"
 #include "settings.hpp"
+#include "settings_profiles.hpp"
 #include "version.hpp"
 #include "video.hpp"
 #include "video_settings.hpp"
@@ -14,6 +19,7 @@
 #include <imgui.h>
 #include <SDL3/SDL.h>
 
+#include <array>
 #include <chrono>
 #include <string>
 
@@ -23,16 +29,11 @@ using namespace std::literals;
 
 const std::string WINDOW_SETTINGS_TITLE = "Settings";
 
-static std::string get_resolution_label(const DisplaySettings &display_settings) {
-	return
-		std::to_string(display_settings.width) + "x"
-		+ std::to_string(display_settings.height) + " @ "
-		+ std::to_string(display_settings.refresh_rate) + "Hz"
-		;
-}
+static const char *const UNKNOWN_DISPLAY_LABEL = "Unknown Display";
 
-static std::string get_unique_display_name(const DisplayInfo &display_info) {
-	return std::to_string(display_info.id) + ": " + display_info.name;
+static const char *get_display_label(const DisplayRegistry &registry, SDL_DisplayID display_id) {
+	const DisplayEntry *entry = registry.find(display_id);
+	return entry != nullptr ? entry->label.c_str() : UNKNOWN_DISPLAY_LABEL;
 }
 
 struct WindowSettings::D {
@@ -44,6 +45,7 @@ struct WindowSettings::D {
 	bool resolution_just_changed = false;
 	bool resolution_needs_confirmation = false;
 	bool show_about = false;
+	std::array<char, SettingsProfiles::MAX_NAME_LENGTH + 1> new_profile_name {};
 
 	D()
 		:
@@ -113,7 +115,10 @@ void WindowSettings::draw(const GuiContext &guictx, bool *p_open) {
 
 	draw_app_info(guictx);
 	ImGui::Separator();
+	draw_profile_settings(guictx);
+	ImGui::Separator();
 	draw_display_settings(guictx);
+	draw_render_driver_settings(guictx);
 	draw_vsync_settings(guictx);
 	ImGui::Separator();
 	draw_fps_settings(guictx);
@@ -164,13 +169,12 @@ void WindowSettings::draw_display_settings(const GuiContext &guictx) {
 	if (
 		ImGui::BeginCombo(
 			"Display mode",
-			get_display_mode_label(d->video_mode_settings.display_mode).c_str()
+			get_display_mode_label(d->video_mode_settings.display_mode)
 		)
 	) {
 		for (const auto &mode : available_display_modes) {
 			const bool is_selected = (mode == d->video_mode_settings.display_mode);
-			const std::string label = get_display_mode_label(mode);
-			if (ImGui::Selectable(label.c_str(), is_selected)) {
+			if (ImGui::Selectable(get_display_mode_label(mode), is_selected)) {
 				d->video_mode_settings.display_mode = mode;
 				if (!is_selected && mode == DisplayMode::FULLSCREEN) {
 					// When switching to fullscreen, pick the best available mode
@@ -187,14 +191,14 @@ void WindowSettings::draw_display_settings(const GuiContext &guictx) {
 		ImGui::EndCombo();
 	}
 	// Display selection
+	const DisplayRegistry &display_registry = guictx.app.display_registry();
 	if (d->video_mode_settings.display_mode != DisplayMode::WINDOWED) {
-		const DisplayInfo current_display_info = get_display_info(d->video_mode_settings.display_id);
-		if (ImGui::BeginCombo("Display", get_unique_display_name(current_display_info).c_str())) {
-			std::vector<DisplayInfo> displays_info = get_available_displays_info();
-			for (const auto &display_info : displays_info) {
-				const bool is_selected = (display_info.id == current_display_info.id);
-				if (ImGui::Selectable(get_unique_display_name(display_info).c_str(), is_selected)) {
-					d->video_mode_settings.display_id = display_info.id;
+		const SDL_DisplayID current_display_id = d->video_mode_settings.display_id;
+		if (ImGui::BeginCombo("Display", get_display_label(display_registry, current_display_id))) {
+			for (const DisplayEntry &display : display_registry.displays()) {
+				const bool is_selected = (display.info.id == current_display_id);
+				if (ImGui::Selectable(display.label.c_str(), is_selected)) {
+					d->video_mode_settings.display_id = display.info.id;
 					if (!is_selected && d->video_mode_settings.display_mode == DisplayMode::FULLSCREEN) {
 						// When changing display in fullscreen mode, pick the best available mode
 						d->video_mode_settings = get_best_fullscreen_settings_for_window_and_display(
@@ -213,17 +217,29 @@ void WindowSettings::draw_display_settings(const GuiContext &guictx) {
 		if (display_id == 0) {
 			display_id = SDL_GetDisplayForWindow(main_window);
 		}
-		const std::vector<VideoModeSettings> video_mode_settings_list =
-			get_available_display_modes(display_id);
-		const std::string current_resolution_label =
-			get_resolution_label(d->video_mode_settings.display_settings);
-		if (ImGui::BeginCombo("Resolution", current_resolution_label.c_str())) {
-			for (const auto &video_mode_settings : video_mode_settings_list) {
+		const DisplayEntry *display = display_registry.find(display_id);
+		const size_t n_modes = display != nullptr ? display->modes.size() : 0;
+		// The label of a listed mode is ready; make one only for the others.
+		const char *current_resolution_label = nullptr;
+		for (size_t i = 0; i < n_modes && current_resolution_label == nullptr; ++i) {
+			if (display->modes[i].display_settings == d->video_mode_settings.display_settings) {
+				current_resolution_label = display->mode_labels[i].c_str();
+			}
+		}
+		char unlisted_resolution_label[RESOLUTION_LABEL_SIZE];
+		if (current_resolution_label == nullptr) {
+			format_resolution_label(
+				unlisted_resolution_label, sizeof(unlisted_resolution_label),
+				d->video_mode_settings.display_settings
+			);
+			current_resolution_label = unlisted_resolution_label;
+		}
+		if (ImGui::BeginCombo("Resolution", current_resolution_label)) {
+			for (size_t i = 0; i < n_modes; ++i) {
+				const DisplaySettings &display_settings = display->modes[i].display_settings;
 				const bool is_selected =
-					video_mode_settings.display_settings == d->video_mode_settings.display_settings;
-				const DisplaySettings &display_settings = video_mode_settings.display_settings;
-				const std::string label = get_resolution_label(display_settings);
-				if (ImGui::Selectable(label.c_str(), is_selected)) {
+					display_settings == d->video_mode_settings.display_settings;
+				if (ImGui::Selectable(display->mode_labels[i].c_str(), is_selected)) {
 					d->video_mode_settings.display_settings = display_settings;
 				}
 				if (is_selected) {
@@ -242,16 +258,20 @@ void WindowSettings::draw_display_settings(const GuiContext &guictx) {
 		const VideoModeSettings new_video_mode_settings =
 			d->merge_factual_window_settings_with_settings_from_ui_with(guictx.app.settings(), main_window);
 		if (new_video_mode_settings != factual_video_mode_settings) {
-			const std::string display_mode_label = get_display_mode_label(new_video_mode_settings.display_mode);
-			const DisplayInfo display_info = get_display_info(new_video_mode_settings.display_id);
+			const char *display_mode_label = get_display_mode_label(new_video_mode_settings.display_mode);
 			guictx.app.logger().info() << "Changing display mode to " << display_mode_label << std::endl;
 			if (new_video_mode_settings.display_id != factual_video_mode_settings.display_id) {
-				guictx.app.logger().info() << "Changing display to " << get_unique_display_name(display_info) << std::endl;
+				guictx.app.logger().info() << "Changing display to "
+					<< get_display_label(display_registry, new_video_mode_settings.display_id)
+					<< std::endl;
 			}
 			if (new_video_mode_settings.display_settings != factual_video_mode_settings.display_settings) {
-				guictx.app.logger().info() << "Changing resolution to "
-					<< get_resolution_label(new_video_mode_settings.display_settings)
-					<< std::endl;
+				char resolution_label[RESOLUTION_LABEL_SIZE];
+				format_resolution_label(
+					resolution_label, sizeof(resolution_label),
+					new_video_mode_settings.display_settings
+				);
+				guictx.app.logger().info() << "Changing resolution to " << resolution_label << std::endl;
 			}
 			d->original_video_mode_settings = factual_video_mode_settings;
 			if (
@@ -277,6 +297,67 @@ void WindowSettings::draw_display_settings(const GuiContext &guictx) {
 	ImGui::SetItemTooltip("Reload display settings from the actual window settings");
 }
 
+void WindowSettings::draw_profile_settings(const GuiContext &guictx) {
+	const SettingsProfiles &profiles = guictx.app.settings_profiles();
+	bool switched = false;
+	ImGui::SetNextItemWidth(150.0f);
+	if (ImGui::BeginCombo("Profile", profiles.active().c_str())) {
+		for (const std::string &name : profiles.names()) {
+			if (ImGui::Selectable(name.c_str(), name == profiles.active())) {
+				switched = guictx.app.switch_profile(name);
+			}
+		}
+		ImGui::EndCombo();
+	}
+	ImGui::SetNextItemWidth(150.0f);
+	ImGui::InputText("##new_profile", d->new_profile_name.data(), d->new_profile_name.size());
+	ImGui::SameLine();
+	const std::string new_profile_name = d->new_profile_name.data();
+	ImGui::BeginDisabled(
+		!SettingsProfiles::is_valid_name(new_profile_name)
+		|| profiles.has(new_profile_name)
+	);
+	if (ImGui::Button("New profile")) {
+		switched = guictx.app.create_profile(new_profile_name);
+		d->new_profile_name.fill('\0');
+	}
+	ImGui::EndDisabled();
+	ImGui::SetItemTooltip("Copy the current settings into a new profile; F6 switches profiles");
+	if (switched) {
+		d->reset_display_settings_to_factual(guictx.app.window());
+	}
+}
+
+void WindowSettings::draw_render_driver_settings(const GuiContext &guictx) {
+	static const char *const automatic_label = "Automatic";
+
+	const std::string &configured = guictx.app.settings().render_driver;
+	auto select_driver = [&guictx](const std::string &driver) {
+		guictx.app.logger().info()
+			<< "Render driver changed to "
+			<< (driver.empty() ? automatic_label : driver.c_str())
+			<< std::endl;
+		guictx.app.set_render_driver(driver);
+	};
+
+	ImGui::SetNextItemWidth(100.0f);
+	if (ImGui::BeginCombo("Render driver", configured.empty() ? automatic_label : configured.c_str())) {
+		if (ImGui::Selectable(automatic_label, configured.empty()) && !configured.empty()) {
+			select_driver({});
+		}
+		const int driver_count = SDL_GetNumRenderDrivers();
+		for (int i = 0; i < driver_count; ++i) {
+			const char *driver = SDL_GetRenderDriver(i);
+			if (ImGui::Selectable(driver, configured == driver) && configured != driver) {
+				select_driver(driver);
+			}
+		}
+		ImGui::EndCombo();
+	}
+	ImGui::SameLine();
+	ImGui::Text("In use: %s", SDL_GetRendererName(guictx.app.renderer()));
+}
+
 void WindowSettings::draw_vsync_settings(const GuiContext &guictx) {
 	static const std::array<int, 3> defined_vsync_modes = {
 		SDL_RENDERER_VSYNC_DISABLED,
@@ -294,12 +375,11 @@ void WindowSettings::draw_vsync_settings(const GuiContext &guictx) {
 		vsync_get_error = SDL_GetError();
 	}
 	auto set_vsync = [&guictx](int new_vsync) {
-		if (SDL_SetRenderVSync(guictx.app.renderer(), new_vsync)) {
+		if (guictx.app.set_vsync(new_vsync)) {
 			guictx.app.logger().info()
 				<< "Vsync changed to "
 				<< get_vsync_state_label(new_vsync)
 				<< std::endl;
-			guictx.app.settings().vsync = new_vsync;
 		} else {
 			guictx.app.logger().error()
 				<< "Failed to change vsync to "
@@ -360,6 +440,34 @@ void WindowSettings::draw_vsync_settings(const GuiContext &guictx) {
 		ImGui::SameLine();
 		ImGui::Text("%s", vsync_get_error.c_str());
 	}
+
+	// What the presents show the driver does with it.
+	const PresentTimingReport &present = guictx.app.present_timing().report();
+	ImGui::SameLine();
+	if (present.observed == ObservedVsync::SYNCED || present.observed == ObservedVsync::PACED) {
+		ImGui::Text(
+			"Observed: %s, 1 out of %d, %d queued",
+			observed_vsync_label(present.observed),
+			present.interval,
+			present.queued_frames
+		);
+	} else {
+		ImGui::Text("Observed: %s", observed_vsync_label(present.observed));
+	}
+	ImGui::SetItemTooltip(
+		"Present call p50 %.2f ms, p99 %.2f ms\n"
+		"Present interval p50 %.2f ms, p99 %.2f ms\n"
+		"Refresh period %.2f ms",
+		present.call_p50_ms, present.call_p99_ms,
+		present.interval_p50_ms, present.interval_p99_ms,
+		present.refresh_period_ms
+	);
+	if (present.mismatch) {
+		ImGui::TextColored(
+			{ 1.0f, 0.8f, 0.0f, 1.0f },
+			"The driver doesn't follow the VSync setting"
+		);
+	}
 }
 
 void WindowSettings::draw_display_confirmation_popup(const GuiContext &guictx) {
@@ -389,8 +497,10 @@ void WindowSettings::draw_display_confirmation_popup(const GuiContext &guictx) {
 }
 
 void WindowSettings::draw_fps_settings(const GuiContext &guictx) {
+	Settings &settings = guictx.app.settings();
 	ImGui::Checkbox("Show FPS", &guictx.app.settings().show_fps);
 	ImGui::Checkbox("Show UI frame counter", &guictx.app.settings().show_ui_frame_counter);
+	ImGui::BeginDisabled(settings.lock_to_refresh_rate);
 	if (
 		ImGui::Checkbox(
 			"Limit FPS",
@@ -409,6 +519,34 @@ void WindowSettings::draw_fps_settings(const GuiContext &guictx) {
 	) {
 		guictx.app.recalculate_fps_clock();
 	}
+	ImGui::EndDisabled();
+	if (ImGui::Checkbox("Lock to refresh rate", &settings.lock_to_refresh_rate)) {
+		guictx.app.recalculate_fps_clock();
+	}
+	ImGui::SetItemTooltip("Pace the frames to an exact fraction of the display refresh rate");
+	ImGui::SameLine();
+	ImGui::SetNextItemWidth(80.0f);
+	if (
+		ImGui::SliderInt(
+			"Divisor", &settings.refresh_divisor,
+			1, FramePacer::MAX_DIVISOR, "1/%d", ImGuiSliderFlags_AlwaysClamp
+		)
+	) {
+		guictx.app.recalculate_fps_clock();
+	}
+	if (settings.lock_to_refresh_rate) {
+		const FramePacer &pacer = guictx.app.frame_pacer();
+		if (pacer.enabled()) {
+			ImGui::Text(
+				"Paced at %.3f FPS, phase error %.3f ms, resyncs %llu",
+				pacer.rate_hz(),
+				pacer.phase_error_ns() / 1e6,
+				static_cast<unsigned long long>(pacer.resyncs())
+			);
+		} else {
+			ImGui::TextUnformatted("Refresh rate unknown; Target FPS is used");
+		}
+	}
 }
 
 void WindowSettings::draw_ui_settings(const GuiContext &guictx) {
@@ -416,7 +554,10 @@ void WindowSettings::draw_ui_settings(const GuiContext &guictx) {
 	ImGui::Checkbox("Show help at start", &guictx.app.settings().show_help_at_start);
 	ImGui::Checkbox("Show settings at start", &guictx.app.settings().show_settings_at_start);
 	ImGui::Checkbox("Show program log", &guictx.app.settings().show_program_log);
+	ImGui::Checkbox("Show performance dashboard", &guictx.app.settings().show_performance_dashboard);
 	ImGui::Checkbox("Show joystick info", &guictx.app.settings().show_joystick_info);
+	ImGui::Checkbox("Show mouse info", &guictx.app.settings().show_mouse_info);
+	ImGui::Checkbox("Show keyboard info", &guictx.app.settings().show_keyboard_info);
 }
 
 void WindowSettings::draw_gizmo_settings(const GuiContext &guictx) {
@@ -453,11 +594,52 @@ void WindowSettings::draw_gizmo_settings(const GuiContext &guictx) {
 		guictx.app.arena().set_gizmos_speed(guictx.app.settings().gizmo_speed);
 	}
 	// Joystick configuration
+	Settings &settings = guictx.app.settings();
+	bool axis_response_changed = false;
+	ImGui::SetNextItemWidth(120.0f);
+	axis_response_changed |= ImGui::DragInt(
+		"Joystick deadzone", &settings.joystick_deadzone,
+		50.0f, 0, SDL_JOYSTICK_AXIS_MAX, "%d", ImGuiSliderFlags_AlwaysClamp
+	);
 	ImGui::SetNextItemWidth(120.0f);
-	ImGui::DragInt(
-		"Joystick deadzone", &guictx.app.settings().joystick_deadzone,
+	axis_response_changed |= ImGui::DragInt(
+		"Joystick outer deadzone", &settings.joystick_outer_deadzone,
 		50.0f, 0, SDL_JOYSTICK_AXIS_MAX, "%d", ImGuiSliderFlags_AlwaysClamp
 	);
+	ImGui::SetNextItemWidth(120.0f);
+	axis_response_changed |= ImGui::DragFloat(
+		"Joystick anti-deadzone", &settings.joystick_anti_deadzone,
+		0.005f, 0.0f, 1.0f, "%.3f", ImGuiSliderFlags_AlwaysClamp
+	);
+	ImGui::SetNextItemWidth(120.0f);
+	axis_response_changed |= ImGui::DragFloat(
+		"Joystick response exponent", &settings.joystick_response_exponent,
+		0.01f, 0.1f, 5.0f, "%.2f", ImGuiSliderFlags_AlwaysClamp
+	);
+	axis_response_changed |= ImGui::Checkbox(
+		"Joystick radial deadzone", &settings.joystick_radial_deadzone
+	);
+	if (axis_response_changed) {
+		guictx.app.recalculate_axis_response();
+	}
+	// Positive half of the axis, as the curve is symmetrical.
+	static const int RESPONSE_PLOT_SAMPLES = 64;
+	const AxisResponseCurve &curve = guictx.app.axis_response().curve();
+	ImGui::PlotLines(
+		"Joystick response",
+		[](void *data, int idx) -> float {
+			const auto &curve = *static_cast<const AxisResponseCurve *>(data);
+			return curve.apply(static_cast<float>(idx) / (RESPONSE_PLOT_SAMPLES - 1));
+		},
+		const_cast<AxisResponseCurve *>(&curve),
+		RESPONSE_PLOT_SAMPLES, 0, nullptr, 0.0f, 1.0f, { 120.0f, 60.0f }
+	);
+	ImGui::Checkbox("Gyro steering", &settings.gyro_steering);
+	ImGui::SetNextItemWidth(120.0f);
+	ImGui::DragFloat(
+		"Gyro sensitivity", &settings.gyro_sensitivity,
+		1.0f, 1.0f, 10000.0f, "%.0f px/rad", ImGuiSliderFlags_AlwaysClamp
+	);
 }
 
 void WindowSettings::draw_background_settings(const GuiContext &guictx) {
@@ -21,8 +21,10 @@ private:
 	std::unique_ptr<D> d;
 
 	void draw_app_info(const GuiContext &guictx);
+	void draw_profile_settings(const GuiContext &guictx);
 	void draw_display_settings(const GuiContext &guictx);
 	void draw_display_confirmation_popup(const GuiContext &guictx);
+	void draw_render_driver_settings(const GuiContext &guictx);
 	void draw_vsync_settings(const GuiContext &guictx);
 	void draw_fps_settings(const GuiContext &guictx);
 	void draw_ui_settings(const GuiContext &guictx);
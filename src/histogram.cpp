@@ -0,0 +1,77 @@
+#include "histogram.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace robikzinputtest {
+
+static int most_significant_bit(uint64_t value) {
+	int bit = -1;
+	while (value != 0) {
+		value >>= 1;
+		++bit;
+	}
+	return bit;
+}
+
+int Histogram::bucket_index(uint64_t value) {
+	if (value < 2 * SUB_BUCKETS) {
+		return static_cast<int>(value);
+	}
+	const int exponent = most_significant_bit(value) - SUB_BUCKET_BITS;
+	const int sub_bucket = static_cast<int>(value >> exponent) - SUB_BUCKETS;
+	return (exponent + 1) * SUB_BUCKETS + sub_bucket;
+}
+
+uint64_t Histogram::bucket_lower_bound(int index) {
+	if (index < 2 * SUB_BUCKETS) {
+		return static_cast<uint64_t>(index);
+	}
+	const int exponent = index / SUB_BUCKETS - 1;
+	const uint64_t mantissa = static_cast<uint64_t>(index % SUB_BUCKETS + SUB_BUCKETS);
+	return mantissa << exponent;
+}
+
+uint64_t Histogram::bucket_width(int index) {
+	if (index < 2 * SUB_BUCKETS) {
+		return 1;
+	}
+	return uint64_t(1) << (index / SUB_BUCKETS - 1);
+}
+
+void Histogram::add(uint64_t value) {
+	++m_count;
+	m_min = std::min(m_min, value);
+	m_max = std::max(m_max, value);
+	const int index = bucket_index(value);
+	if (index < BUCKET_COUNT) {
+		++m_buckets[index];
+	} else {
+		++m_overflow;
+	}
+}
+
+void Histogram::clear() {
+	*this = Histogram();
+}
+
+uint64_t Histogram::percentile(double fraction) const {
+	if (m_count == 0) {
+		return 0;
+	}
+	const double clamped = std::clamp(fraction, 0.0, 1.0);
+	const uint64_t rank = std::max<uint64_t>(
+		1, static_cast<uint64_t>(std::ceil(clamped * static_cast<double>(m_count)))
+	);
+	uint64_t seen = 0;
+	for (int index = 0; index < BUCKET_COUNT; ++index) {
+		seen += m_buckets[index];
+		if (seen >= rank) {
+			return std::clamp(bucket_midpoint(index), m_min, m_max);
+		}
+	}
+	// The rank falls into the overflow.
+	return m_max;
+}
+
+} // namespace robikzinputtest
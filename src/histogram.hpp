@@ -0,0 +1,57 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+namespace robikzinputtest {
+
+/**
+ * Streaming histogram of non-negative integer values in fixed memory.
+ *
+ * Values below 2 * SUB_BUCKETS are counted exactly. Above that, every
+ * power-of-two range is split into SUB_BUCKETS equal buckets, so
+ * the relative error of a bucket stays below 1 / SUB_BUCKETS at any
+ * magnitude. Values past the last bucket are counted as overflow.
+ */
+class Histogram {
+public:
+	static constexpr int SUB_BUCKET_BITS = 5;
+	static constexpr int SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+	static constexpr int BUCKET_COUNT = 512;
+
+	void add(uint64_t value);
+	void clear();
+
+	uint64_t count() const { return m_count; }
+	uint64_t overflow() const { return m_overflow; }
+	uint64_t min() const { return m_count > 0 ? m_min : 0; }
+	uint64_t max() const { return m_max; }
+
+	/**
+	 * Value below which the given fraction (0.0 - 1.0) of the values
+	 * falls; approximated by the bucket's midpoint.
+	 */
+	uint64_t percentile(double fraction) const;
+
+	/// Number of the bucket that holds the value.
+	static int bucket_index(uint64_t value);
+	/// Lowest value that lands in the bucket.
+	static uint64_t bucket_lower_bound(int index);
+	/// Number of consecutive values that land in the bucket.
+	static uint64_t bucket_width(int index);
+	/// Representative value of the bucket.
+	static uint64_t bucket_midpoint(int index) {
+		return bucket_lower_bound(index) + bucket_width(index) / 2;
+	}
+
+	uint32_t bucket_count(int index) const { return m_buckets[index]; }
+
+private:
+	std::array<uint32_t, BUCKET_COUNT> m_buckets {};
+	uint64_t m_count = 0;
+	uint64_t m_overflow = 0;
+	uint64_t m_min = UINT64_MAX;
+	uint64_t m_max = 0;
+};
+
+} // namespace robikzinputtest
@@ -0,0 +1,592 @@
+#include "input_recording.hpp"
+
+#include "arena.hpp"
+#include "gizmo.hpp"
+#include "sdl_event.hpp"
+#include "sdl_virtual_joystick.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <cstdio>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace robikzinputtest {
+
+namespace {
+
+/*
+  File format
+
+  All numbers are little-endian. The file starts with the magic bytes
+  and the format version, followed by SDL_GetTicksNS() at the start
+  of the recording. Then, records follow until the end of the file.
+  Each record is a type byte followed by the record's payload.
+*/
+
+const char RECORDING_MAGIC[8] = { 'R', 'I', 'T', 'I', 'N', 'P', 'U', 'T' };
+const Uint32 RECORDING_VERSION = 3;
+
+enum RecordType : Uint8 {
+	/// u64 frame delta in nanoseconds
+	RECORD_FRAME = 1,
+	/// u32 joystick ID, u16 axes, u16 buttons, u16 hats,
+	/// u16 gamepad mapping length, gamepad mapping string (may be empty)
+	RECORD_JOYSTICK_ADDED = 2,
+	/// u32 joystick ID
+	RECORD_JOYSTICK_REMOVED = 3,
+	/// u32 event type, u64 timestamp, event-specific payload
+	RECORD_EVENT = 4,
+	/// u8 controller type, u32 controller index
+	RECORD_SPAWN = 5,
+};
+
+struct RecordedJoystickLayout {
+	Uint16 naxes = 0;
+	Uint16 nbuttons = 0;
+	Uint16 nhats = 0;
+	std::string gamepad_mapping;
+};
+
+struct ReplayRecord {
+	RecordType type = RECORD_FRAME;
+	Uint64 delta_ns = 0;
+	SDL_JoystickID which = 0;
+	RecordedJoystickLayout layout;
+	SDL_Event event {};
+	ControllerId controller_id;
+};
+
+/**
+ * Motion and buttons of a physical mouse; touch and pen only emulate
+ * the mouse and drive no controller.
+ */
+bool is_recorded_mouse_event(const SDL_Event &event) {
+	if (
+		event.type != SDL_EVENT_MOUSE_MOTION
+		&& event.type != SDL_EVENT_MOUSE_BUTTON_DOWN
+		&& event.type != SDL_EVENT_MOUSE_BUTTON_UP
+	) {
+		return false;
+	}
+	const SDL_MouseID which = sdl::get_mouse_event_which(event);
+	return which != SDL_TOUCH_MOUSEID && which != SDL_PEN_MOUSEID;
+}
+
+bool is_recorded_event(const SDL_Event &event) {
+	return sdl::is_keyboard_event(event)
+		|| event.type == SDL_EVENT_JOYSTICK_AXIS_MOTION
+		|| event.type == SDL_EVENT_JOYSTICK_HAT_MOTION
+		|| event.type == SDL_EVENT_JOYSTICK_BUTTON_DOWN
+		|| event.type == SDL_EVENT_JOYSTICK_BUTTON_UP
+		|| is_recorded_mouse_event(event)
+		|| event.type == SDL_EVENT_MOUSE_REMOVED
+		;
+}
+
+/// Floats go into the file by their bits.
+bool write_float(SDL_IOStream *io, float value) {
+	Uint32 bits = 0;
+	std::memcpy(&bits, &value, sizeof(bits));
+	return SDL_WriteU32LE(io, bits);
+}
+
+bool read_float(SDL_IOStream *io, float *value) {
+	Uint32 bits = 0;
+	if (!SDL_ReadU32LE(io, &bits))
+		return false;
+	std::memcpy(value, &bits, sizeof(bits));
+	return true;
+}
+
+} // namespace
+
+/*
+  InputRecorder
+*/
+
+InputRecorder::InputRecorder() = default;
+
+InputRecorder::~InputRecorder() {
+	close();
+}
+
+bool InputRecorder::open(const std::string &path) {
+	close();
+	m_io = SDL_IOFromFile(path.c_str(), "wb");
+	if (m_io == nullptr) {
+		std::cerr << "Failed to open input recording " << path << ": " << SDL_GetError() << std::endl;
+		return false;
+	}
+	m_write_ok = true;
+	m_write_ok &= SDL_WriteIO(m_io, RECORDING_MAGIC, sizeof(RECORDING_MAGIC)) == sizeof(RECORDING_MAGIC);
+	m_write_ok &= SDL_WriteU32LE(m_io, RECORDING_VERSION);
+	m_write_ok &= SDL_WriteU64LE(m_io, SDL_GetTicksNS());
+	return m_write_ok;
+}
+
+void InputRecorder::close() {
+	if (m_io != nullptr) {
+		if (!m_write_ok) {
+			std::cerr << "Input recording is incomplete; some writes have failed" << std::endl;
+		}
+		SDL_CloseIO(m_io);
+		m_io = nullptr;
+	}
+}
+
+void InputRecorder::record_frame(const FrameTime &frame_time) {
+	if (m_io == nullptr)
+		return;
+	const auto delta = std::chrono::duration_cast<std::chrono::nanoseconds>(
+		frame_time.currtick - frame_time.prevtick
+	);
+	m_write_ok &= SDL_WriteU8(m_io, RECORD_FRAME);
+	m_write_ok &= SDL_WriteU64LE(m_io, static_cast<Uint64>(delta.count()));
+}
+
+void InputRecorder::record_event(const SDL_Event &event) {
+	if (m_io == nullptr || !is_recorded_event(event))
+		return;
+	m_write_ok &= SDL_WriteU8(m_io, RECORD_EVENT);
+	m_write_ok &= SDL_WriteU32LE(m_io, event.type);
+	m_write_ok &= SDL_WriteU64LE(m_io, event.common.timestamp);
+	switch (event.type) {
+	case SDL_EVENT_KEY_DOWN:
+	case SDL_EVENT_KEY_UP:
+		m_write_ok &= SDL_WriteU32LE(m_io, event.key.scancode);
+		m_write_ok &= SDL_WriteU32LE(m_io, event.key.key);
+		m_write_ok &= SDL_WriteU16LE(m_io, event.key.mod);
+		m_write_ok &= SDL_WriteU8(m_io, event.key.down);
+		m_write_ok &= SDL_WriteU8(m_io, event.key.repeat);
+		break;
+	case SDL_EVENT_JOYSTICK_AXIS_MOTION:
+		m_write_ok &= SDL_WriteU32LE(m_io, event.jaxis.which);
+		m_write_ok &= SDL_WriteU8(m_io, event.jaxis.axis);
+		m_write_ok &= SDL_WriteS16LE(m_io, event.jaxis.value);
+		break;
+	case SDL_EVENT_JOYSTICK_HAT_MOTION:
+		m_write_ok &= SDL_WriteU32LE(m_io, event.jhat.which);
+		m_write_ok &= SDL_WriteU8(m_io, event.jhat.hat);
+		m_write_ok &= SDL_WriteU8(m_io, event.jhat.value);
+		break;
+	case SDL_EVENT_JOYSTICK_BUTTON_DOWN:
+	case SDL_EVENT_JOYSTICK_BUTTON_UP:
+		m_write_ok &= SDL_WriteU32LE(m_io, event.jbutton.which);
+		m_write_ok &= SDL_WriteU8(m_io, event.jbutton.button);
+		m_write_ok &= SDL_WriteU8(m_io, event.jbutton.down);
+		break;
+	case SDL_EVENT_MOUSE_MOTION:
+		// Only the relative motion drives the gizmo.
+		m_write_ok &= SDL_WriteU32LE(m_io, event.motion.which);
+		m_write_ok &= write_float(m_io, event.motion.xrel);
+		m_write_ok &= write_float(m_io, event.motion.yrel);
+		break;
+	case SDL_EVENT_MOUSE_BUTTON_DOWN:
+	case SDL_EVENT_MOUSE_BUTTON_UP:
+		m_write_ok &= SDL_WriteU32LE(m_io, event.button.which);
+		m_write_ok &= SDL_WriteU8(m_io, event.button.button);
+		m_write_ok &= SDL_WriteU8(m_io, event.button.down);
+		break;
+	case SDL_EVENT_MOUSE_REMOVED:
+		m_write_ok &= SDL_WriteU32LE(m_io, event.mdevice.which);
+		break;
+	}
+}
+
+void InputRecorder::record_joystick_added(SDL_JoystickID which, SDL_Joystick *joystick) {
+	if (m_io == nullptr)
+		return;
+	m_write_ok &= SDL_WriteU8(m_io, RECORD_JOYSTICK_ADDED);
+	m_write_ok &= SDL_WriteU32LE(m_io, which);
+	m_write_ok &= SDL_WriteU16LE(m_io, static_cast<Uint16>(std::max(0, SDL_GetNumJoystickAxes(joystick))));
+	m_write_ok &= SDL_WriteU16LE(m_io, static_cast<Uint16>(std::max(0, SDL_GetNumJoystickButtons(joystick))));
+	m_write_ok &= SDL_WriteU16LE(m_io, static_cast<Uint16>(std::max(0, SDL_GetNumJoystickHats(joystick))));
+	// Replay needs the same gamepad mapping to translate the raw controls
+	// the same way.
+	std::string gamepad_mapping;
+	if (char *mapping = SDL_GetGamepadMappingForID(which)) {
+		gamepad_mapping = mapping;
+		SDL_free(mapping);
+	}
+	if (gamepad_mapping.size() > UINT16_MAX) {
+		gamepad_mapping.clear();
+	}
+	m_write_ok &= SDL_WriteU16LE(m_io, static_cast<Uint16>(gamepad_mapping.size()));
+	if (!gamepad_mapping.empty()) {
+		m_write_ok &= SDL_WriteIO(m_io, gamepad_mapping.data(), gamepad_mapping.size()) == gamepad_mapping.size();
+	}
+}
+
+void InputRecorder::record_joystick_removed(SDL_JoystickID which) {
+	if (m_io == nullptr)
+		return;
+	m_write_ok &= SDL_WriteU8(m_io, RECORD_JOYSTICK_REMOVED);
+	m_write_ok &= SDL_WriteU32LE(m_io, which);
+}
+
+void InputRecorder::record_spawn(const ControllerId &controller_id) {
+	if (m_io == nullptr)
+		return;
+	m_write_ok &= SDL_WriteU8(m_io, RECORD_SPAWN);
+	m_write_ok &= SDL_WriteU8(m_io, static_cast<Uint8>(controller_id.type));
+	m_write_ok &= SDL_WriteU32LE(m_io, controller_id.index);
+}
+
+/*
+  InputReplay
+*/
+
+static bool read_event_record(SDL_IOStream *io, SDL_Event &event) {
+	Uint32 type = 0;
+	Uint64 timestamp = 0;
+	if (!SDL_ReadU32LE(io, &type) || !SDL_ReadU64LE(io, &timestamp))
+		return false;
+	event = {};
+	event.type = type;
+	event.common.timestamp = timestamp;
+	Uint8 u8 = 0;
+	switch (type) {
+	case SDL_EVENT_KEY_DOWN:
+	case SDL_EVENT_KEY_UP: {
+		Uint32 scancode = 0;
+		Uint8 repeat = 0;
+		if (
+			!SDL_ReadU32LE(io, &scancode)
+			|| !SDL_ReadU32LE(io, &event.key.key)
+			|| !SDL_ReadU16LE(io, &event.key.mod)
+			|| !SDL_ReadU8(io, &u8)
+			|| !SDL_ReadU8(io, &repeat)
+		) {
+			return false;
+		}
+		event.key.scancode = static_cast<SDL_Scancode>(scancode);
+		event.key.down = u8 != 0;
+		event.key.repeat = repeat != 0;
+		return true;
+	}
+	case SDL_EVENT_JOYSTICK_AXIS_MOTION:
+		return SDL_ReadU32LE(io, &event.jaxis.which)
+			&& SDL_ReadU8(io, &event.jaxis.axis)
+			&& SDL_ReadS16LE(io, &event.jaxis.value);
+	case SDL_EVENT_JOYSTICK_HAT_MOTION:
+		return SDL_ReadU32LE(io, &event.jhat.which)
+			&& SDL_ReadU8(io, &event.jhat.hat)
+			&& SDL_ReadU8(io, &event.jhat.value);
+	case SDL_EVENT_JOYSTICK_BUTTON_DOWN:
+	case SDL_EVENT_JOYSTICK_BUTTON_UP:
+		if (
+			!SDL_ReadU32LE(io, &event.jbutton.which)
+			|| !SDL_ReadU8(io, &event.jbutton.button)
+			|| !SDL_ReadU8(io, &u8)
+		) {
+			return false;
+		}
+		event.jbutton.down = u8 != 0;
+		return true;
+	case SDL_EVENT_MOUSE_MOTION:
+		return SDL_ReadU32LE(io, &event.motion.which)
+			&& read_float(io, &event.motion.xrel)
+			&& read_float(io, &event.motion.yrel);
+	case SDL_EVENT_MOUSE_BUTTON_DOWN:
+	case SDL_EVENT_MOUSE_BUTTON_UP:
+		if (
+			!SDL_ReadU32LE(io, &event.button.which)
+			|| !SDL_ReadU8(io, &event.button.button)
+			|| !SDL_ReadU8(io, &u8)
+		) {
+			return false;
+		}
+		event.button.down = u8 != 0;
+		return true;
+	case SDL_EVENT_MOUSE_REMOVED:
+		return SDL_ReadU32LE(io, &event.mdevice.which);
+	default:
+		// Unknown event; the payload size can't be established.
+		return false;
+	}
+}
+
+static bool read_record(SDL_IOStream *io, ReplayRecord &record) {
+	Uint8 type = 0;
+	if (!SDL_ReadU8(io, &type))
+		return false;
+	record = {};
+	record.type = static_cast<RecordType>(type);
+	switch (record.type) {
+	case RECORD_FRAME:
+		return SDL_ReadU64LE(io, &record.delta_ns);
+	case RECORD_JOYSTICK_ADDED: {
+		Uint16 mapping_length = 0;
+		if (
+			!SDL_ReadU32LE(io, &record.which)
+			|| !SDL_ReadU16LE(io, &record.layout.naxes)
+			|| !SDL_ReadU16LE(io, &record.layout.nbuttons)
+			|| !SDL_ReadU16LE(io, &record.layout.nhats)
+			|| !SDL_ReadU16LE(io, &mapping_length)
+		) {
+			return false;
+		}
+		record.layout.gamepad_mapping.resize(mapping_length);
+		return mapping_length == 0
+			|| SDL_ReadIO(io, record.layout.gamepad_mapping.data(), mapping_length) == mapping_length;
+	}
+	case RECORD_JOYSTICK_REMOVED:
+		return SDL_ReadU32LE(io, &record.which);
+	case RECORD_EVENT:
+		return read_event_record(io, record.event);
+	case RECORD_SPAWN: {
+		Uint8 controller_type = 0;
+		if (
+			!SDL_ReadU8(io, &controller_type)
+			|| !SDL_ReadU32LE(io, &record.controller_id.index)
+		) {
+			return false;
+		}
+		record.controller_id.type = static_cast<ControllerId::Type>(controller_type);
+		return true;
+	}
+	default:
+		return false;
+	}
+}
+
+struct InputReplay::D {
+	std::vector<ReplayRecord> records;
+	size_t cursor = 0;
+
+	Uint64 recording_start_ticks = 0;
+	Uint64 replay_start_ticks = 0;
+	TimePoint replay_start;
+	Duration elapsed = Duration::zero();
+	bool started = false;
+
+	/// Recorded joystick ID -> virtual joystick standing in for it.
+	std::map<SDL_JoystickID, std::unique_ptr<sdl::VirtualJoystick>> joysticks;
+
+	SDL_JoystickID virtual_id(SDL_JoystickID recorded_which) const {
+		auto it = joysticks.find(recorded_which);
+		return it != joysticks.end() ? it->second->id() : 0;
+	}
+
+	void attach_joystick(const ReplayRecord &record) {
+		SDL_VirtualJoystickDesc desc;
+		SDL_INIT_INTERFACE(&desc);
+		desc.type = SDL_JOYSTICK_TYPE_UNKNOWN;
+		desc.naxes = record.layout.naxes;
+		desc.nbuttons = record.layout.nbuttons;
+		desc.nhats = record.layout.nhats;
+		desc.name = "Input Replay Joystick";
+		auto joystick = std::make_unique<sdl::VirtualJoystick>(desc);
+		if (joystick->valid()) {
+			if (!record.layout.gamepad_mapping.empty()) {
+				SDL_SetGamepadMapping(joystick->id(), record.layout.gamepad_mapping.c_str());
+			}
+			joysticks[record.which] = std::move(joystick);
+		}
+	}
+
+	/**
+	 * Apply the recorded joystick input to the virtual joystick, so that
+	 * the joystick state queried through SDL matches the event.
+	 */
+	bool update_joystick(SDL_Event &event) {
+		// All joystick events share the layout of the 'which' field.
+		auto it = joysticks.find(event.jdevice.which);
+		if (it == joysticks.end())
+			return false;
+		sdl::VirtualJoystick &joystick = *it->second;
+		switch (event.type) {
+		case SDL_EVENT_JOYSTICK_AXIS_MOTION:
+			joystick.set_axis(event.jaxis.axis, event.jaxis.value);
+			break;
+		case SDL_EVENT_JOYSTICK_HAT_MOTION:
+			joystick.set_hat(event.jhat.hat, event.jhat.value);
+			break;
+		case SDL_EVENT_JOYSTICK_BUTTON_DOWN:
+		case SDL_EVENT_JOYSTICK_BUTTON_UP:
+			joystick.set_button(event.jbutton.button, event.jbutton.down);
+			break;
+		}
+		SDL_UpdateJoysticks();
+		event.jdevice.which = joystick.id();
+		return true;
+	}
+};
+
+InputReplay::InputReplay()
+	: d(std::make_unique<D>()) {
+}
+
+InputReplay::~InputReplay() = default;
+
+bool InputReplay::open(const std::string &path) {
+	SDL_IOStream *io = SDL_IOFromFile(path.c_str(), "rb");
+	if (io == nullptr) {
+		std::cerr << "Failed to open input recording " << path << ": " << SDL_GetError() << std::endl;
+		return false;
+	}
+	char magic[sizeof(RECORDING_MAGIC)] = {};
+	Uint32 version = 0;
+	if (
+		SDL_ReadIO(io, magic, sizeof(magic)) != sizeof(magic)
+		|| !std::equal(magic, magic + sizeof(magic), RECORDING_MAGIC)
+		|| !SDL_ReadU32LE(io, &version)
+		|| version != RECORDING_VERSION
+		|| !SDL_ReadU64LE(io, &d->recording_start_ticks)
+	) {
+		std::cerr << "Not a supported input recording: " << path << std::endl;
+		SDL_CloseIO(io);
+		return false;
+	}
+	d->records.clear();
+	ReplayRecord record;
+	while (read_record(io, record)) {
+		d->records.push_back(record);
+	}
+	SDL_CloseIO(io);
+	d->cursor = 0;
+	return true;
+}
+
+bool InputReplay::is_finished() const {
+	return d->cursor >= d->records.size();
+}
+
+FrameTime InputReplay::wait_next_frame() {
+	if (!d->started) {
+		d->started = true;
+		d->replay_start = std::chrono::steady_clock::now();
+		d->replay_start_ticks = SDL_GetTicksNS();
+	}
+	// Anything left over from the previous frame belongs to it.
+	while (d->cursor < d->records.size() && d->records[d->cursor].type != RECORD_FRAME) {
+		++d->cursor;
+	}
+	const Duration prev_elapsed = d->elapsed;
+	if (d->cursor < d->records.size()) {
+		d->elapsed += std::chrono::duration_cast<Duration>(
+			std::chrono::nanoseconds(d->records[d->cursor].delta_ns)
+		);
+		++d->cursor;
+	}
+	const TimePoint due = d->replay_start + d->elapsed;
+	const auto sleep_time = due - std::chrono::steady_clock::now();
+	if (sleep_time > Duration::zero()) {
+		SDL_DelayPrecise(std::chrono::duration_cast<std::chrono::nanoseconds>(sleep_time).count());
+	}
+	return FrameTime::delta(d->replay_start + prev_elapsed, due);
+}
+
+void InputReplay::play_frame(const InjectEventFn &inject_event, const SpawnFn &spawn) {
+	for (; d->cursor < d->records.size(); ++d->cursor) {
+		ReplayRecord &record = d->records[d->cursor];
+		switch (record.type) {
+		case RECORD_FRAME:
+			// Next frame starts.
+			return;
+		case RECORD_JOYSTICK_ADDED:
+			d->attach_joystick(record);
+			break;
+		case RECORD_JOYSTICK_REMOVED:
+			d->joysticks.erase(record.which);
+			break;
+		case RECORD_EVENT: {
+			SDL_Event event = record.event;
+			// Move the event onto the replay's timeline.
+			event.common.timestamp = d->replay_start_ticks
+				+ (
+					event.common.timestamp > d->recording_start_ticks
+					? event.common.timestamp - d->recording_start_ticks
+					: 0
+				);
+			if (sdl::is_joystick_event(event) && !d->update_joystick(event)) {
+				// The joystick's layout wasn't recorded.
+				break;
+			}
+			inject_event(event);
+			break;
+		}
+		case RECORD_SPAWN: {
+			ControllerId controller_id = record.controller_id;
+			if (controller_id.type == ControllerId::TYPE_JOY) {
+				controller_id.index = d->virtual_id(controller_id.index);
+				if (controller_id.index == 0)
+					break;
+			}
+			spawn(controller_id);
+			break;
+		}
+		}
+	}
+}
+
+bool InputReplay::owns_joystick(SDL_JoystickID which) const {
+	for (const auto &it : d->joysticks) {
+		if (it.second->id() == which)
+			return true;
+	}
+	return false;
+}
+
+/*
+  TrajectoryReport
+*/
+
+TrajectoryReport::TrajectoryReport() = default;
+
+TrajectoryReport::~TrajectoryReport() {
+	close();
+}
+
+bool TrajectoryReport::open(const std::string &path) {
+	close();
+	m_io = SDL_IOFromFile(path.c_str(), "w");
+	if (m_io == nullptr) {
+		std::cerr << "Failed to open report " << path << ": " << SDL_GetError() << std::endl;
+		return false;
+	}
+	m_frame = 0;
+	m_elapsed = 0.0;
+	SDL_IOprintf(m_io, "frame,time_s,delta_s,input_latency_us,gizmo,x,y,active\n");
+	return true;
+}
+
+void TrajectoryReport::close() {
+	if (m_io != nullptr) {
+		SDL_CloseIO(m_io);
+		m_io = nullptr;
+	}
+}
+
+void TrajectoryReport::record(
+	const FrameTime &frame_time, const Arena &arena, std::optional<uint64_t> input_latency_us
+) {
+	if (m_io == nullptr)
+		return;
+	m_elapsed += frame_time.delta_seconds;
+	char latency[24] = "";
+	if (input_latency_us) {
+		std::snprintf(latency, sizeof(latency), "%llu", static_cast<unsigned long long>(*input_latency_us));
+	}
+	const auto &gizmos = arena.gizmos();
+	if (gizmos.empty()) {
+		SDL_IOprintf(
+			m_io, "%llu,%.6f,%.6f,%s,-,,,\n",
+			static_cast<unsigned long long>(m_frame), m_elapsed, frame_time.delta_seconds, latency
+		);
+	}
+	for (size_t i = 0; i < gizmos.size(); ++i) {
+		const Gizmo &gizmo = *gizmos[i];
+		SDL_IOprintf(
+			m_io, "%llu,%.6f,%.6f,%s,%zu,%.3f,%.3f,%d\n",
+			static_cast<unsigned long long>(m_frame), m_elapsed, frame_time.delta_seconds, latency,
+			i, gizmo.m_position.x, gizmo.m_position.y, gizmo.is_active() ? 1 : 0
+		);
+	}
+	++m_frame;
+}
+
+} // namespace robikzinputtest
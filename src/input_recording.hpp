@@ -0,0 +1,114 @@
+#pragma once
+
+#include "clock.hpp"
+#include "controller.hpp"
+
+#include <SDL3/SDL.h>
+
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+
+namespace robikzinputtest {
+
+class Arena;
+
+/**
+ * Records the input session into a compact binary file.
+ *
+ * The file is a sequence of frames. Each frame holds the input events
+ * that reached the ControllerSystem during that frame, the joysticks
+ * that were connected or disconnected, the mice that were removed and
+ * the gizmos that were spawned in the Arena.
+ */
+class InputRecorder {
+public:
+	InputRecorder();
+	~InputRecorder();
+
+	bool open(const std::string &path);
+	void close();
+	bool is_open() const { return m_io != nullptr; }
+
+	/// Start a new frame; everything recorded afterwards belongs to it.
+	void record_frame(const FrameTime &frame_time);
+	/// Record an input event that is passed to the ControllerSystem.
+	void record_event(const SDL_Event &event);
+	void record_joystick_added(SDL_JoystickID which, SDL_Joystick *joystick);
+	void record_joystick_removed(SDL_JoystickID which);
+	void record_spawn(const ControllerId &controller_id);
+
+private:
+	SDL_IOStream *m_io = nullptr;
+	bool m_write_ok = true;
+};
+
+/**
+ * Replays the input session recorded by the InputRecorder.
+ *
+ * The replay runs on the recording's timeline: each frame lasts exactly
+ * as long as it did when it was recorded, so the Arena moves the gizmos
+ * along identical trajectories. Joysticks are recreated as SDL virtual
+ * joysticks with the recorded layout; keyboard and mouse events are
+ * injected directly, the mice keeping their recorded IDs.
+ */
+class InputReplay {
+public:
+	using InjectEventFn = std::function<void(const SDL_Event &)>;
+	using SpawnFn = std::function<void(const ControllerId &)>;
+
+	InputReplay();
+	~InputReplay();
+
+	bool open(const std::string &path);
+	bool is_finished() const;
+
+	/**
+	 * Wait until the next recorded frame is due and return its
+	 * frame time on the recording's timeline.
+	 */
+	FrameTime wait_next_frame();
+
+	/**
+	 * Inject everything that was recorded in the current frame.
+	 *
+	 * The joystick IDs in the injected events and spawns refer
+	 * to the virtual joysticks created by the replay.
+	 */
+	void play_frame(const InjectEventFn &inject_event, const SpawnFn &spawn);
+
+	/// Whether the joystick is a virtual device created by the replay.
+	bool owns_joystick(SDL_JoystickID which) const;
+
+private:
+	struct D;
+	std::unique_ptr<D> d;
+};
+
+/**
+ * Writes the per-frame gizmo trajectories as CSV.
+ *
+ * The gizmos are identified by their spawn order, not by the controller,
+ * so the reports of a recorded and a replayed session can be diffed.
+ * Each row also carries the frame's input-to-present latency, empty on
+ * the frames that presented no input.
+ */
+class TrajectoryReport {
+public:
+	TrajectoryReport();
+	~TrajectoryReport();
+
+	bool open(const std::string &path);
+	void close();
+
+	/// Record a presented frame; `input_latency_us` is that of its longest-waiting input.
+	void record(const FrameTime &frame_time, const Arena &arena, std::optional<uint64_t> input_latency_us);
+
+private:
+	SDL_IOStream *m_io = nullptr;
+	uint64_t m_frame = 0;
+	Seconds m_elapsed = 0.0;
+};
+
+} // namespace robikzinputtest
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "latency_tracker.hpp"
+#include "polling_rate_analyzer.hpp"
+
+#include <SDL3/SDL.h>
+
+namespace robikzinputtest {
+
+/**
+ * Timing analysis of a single input device.
+ */
+struct InputTiming {
+	PollingRateAnalyzer polling_rate;
+	LatencyTracker latency;
+
+	void add_event(const SDL_Event &event) {
+		polling_rate.add_event(event);
+		latency.add_input(event.common.timestamp);
+	}
+
+	void clear() {
+		polling_rate.clear();
+		latency.clear();
+	}
+};
+
+} // namespace robikzinputtest
@@ -0,0 +1,75 @@
+#include "joystick_snapshot.hpp"
+
+#include <algorithm>
+#include <cstdio>
+
+namespace robikzinputtest {
+
+static float normalize_axis(int16_t value) {
+	return std::max(-1.0f, static_cast<float>(value) / SDL_JOYSTICK_AXIS_MAX);
+}
+
+void JoystickSnapshot::open(SDL_JoystickID which, SDL_Joystick *joystick) {
+	*this = JoystickSnapshot();
+	std::snprintf(title, sizeof(title), "Joystick %u", static_cast<unsigned>(which));
+
+	SDL_LockJoysticks();
+	n_axes = std::clamp(SDL_GetNumJoystickAxes(joystick), 0, MAX_AXES);
+	n_hats = std::clamp(SDL_GetNumJoystickHats(joystick), 0, MAX_HATS);
+	n_buttons = std::clamp(SDL_GetNumJoystickButtons(joystick), 0, MAX_BUTTONS);
+	for (int axis = 0; axis < n_axes; ++axis) {
+		axes[axis] = SDL_GetJoystickAxis(joystick, axis);
+		axis_history[axis].push(normalize_axis(axes[axis]));
+	}
+	for (int hat = 0; hat < n_hats; ++hat) {
+		hats[hat] = SDL_GetJoystickHat(joystick, hat);
+	}
+	for (int button = 0; button < n_buttons; ++button) {
+		buttons.set(button, SDL_GetJoystickButton(joystick, button));
+	}
+	SDL_UnlockJoysticks();
+	update_buttons_text();
+}
+
+void JoystickSnapshot::handle_event(const SDL_Event &event) {
+	switch (event.type) {
+	case SDL_EVENT_JOYSTICK_AXIS_MOTION:
+		if (event.jaxis.axis < n_axes) {
+			axes[event.jaxis.axis] = event.jaxis.value;
+			axis_history[event.jaxis.axis].push(normalize_axis(event.jaxis.value));
+		}
+		break;
+	case SDL_EVENT_JOYSTICK_HAT_MOTION:
+		if (event.jhat.hat < n_hats) {
+			hats[event.jhat.hat] = event.jhat.value;
+		}
+		break;
+	case SDL_EVENT_JOYSTICK_BUTTON_DOWN:
+	case SDL_EVENT_JOYSTICK_BUTTON_UP:
+		if (event.jbutton.button < n_buttons) {
+			buttons.set(event.jbutton.button, event.jbutton.down);
+			update_buttons_text();
+		}
+		break;
+	default:
+		break;
+	}
+}
+
+void JoystickSnapshot::update_buttons_text() {
+	size_t length = 0;
+	buttons_text[0] = '\0';
+	for (int button = 0; button < n_buttons; ++button) {
+		if (buttons.test(button)) {
+			const int written = std::snprintf(
+				buttons_text + length, sizeof(buttons_text) - length, "%d ", button
+			);
+			if (written < 0 || static_cast<size_t>(written) >= sizeof(buttons_text) - length) {
+				break;
+			}
+			length += static_cast<size_t>(written);
+		}
+	}
+}
+
+} // namespace robikzinputtest
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "ring_buffer.hpp"
+
+#include <SDL3/SDL.h>
+
+#include <array>
+#include <bitset>
+#include <cstdint>
+
+namespace robikzinputtest {
+
+/**
+ * State of a joystick as seen through its events.
+ *
+ * Kept up to date by the event loop, so that the GUI can show it
+ * without locking the joysticks or allocating.
+ */
+struct JoystickSnapshot {
+	static constexpr int MAX_AXES = 16;
+	static constexpr int MAX_HATS = 4;
+	static constexpr int MAX_BUTTONS = 64;
+	/// Number of axis values kept per axis.
+	static constexpr size_t AXIS_HISTORY = 128;
+
+	using AxisHistory = RingBuffer<float, AXIS_HISTORY>;
+
+	char title[32] = {};
+	int n_axes = 0;
+	int n_hats = 0;
+	int n_buttons = 0;
+
+	std::array<int16_t, MAX_AXES> axes {};
+	/// Recent axis values, normalized to -1.0 - 1.0; one per event.
+	std::array<AxisHistory, MAX_AXES> axis_history {};
+	std::array<uint8_t, MAX_HATS> hats {};
+	std::bitset<MAX_BUTTONS> buttons;
+	/// Space-separated list of the pressed buttons.
+	char buttons_text[MAX_BUTTONS * 3 + 1] = {};
+
+	/// Take the initial state of the just opened joystick.
+	void open(SDL_JoystickID which, SDL_Joystick *joystick);
+	void handle_event(const SDL_Event &event);
+
+private:
+	void update_buttons_text();
+};
+
+} // namespace robikzinputtest
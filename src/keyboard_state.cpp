@@ -0,0 +1,95 @@
+#include "keyboard_state.hpp"
+
+#include "csv.hpp"
+
+#include <algorithm>
+#include <iomanip>
+
+namespace robikzinputtest {
+
+/*
+  KeyboardState
+*/
+
+bool KeyboardState::handle_event(const SDL_Event &event) {
+	if (event.type != SDL_EVENT_KEY_DOWN && event.type != SDL_EVENT_KEY_UP) {
+		return false;
+	}
+	if (event.key.scancode >= 0 && event.key.scancode < SDL_SCANCODE_COUNT) {
+		m_down.set(event.key.scancode, event.key.down);
+	}
+	return true;
+}
+
+/*
+  KeyboardAnalyzer
+*/
+
+static Uint64 min_nonzero(Uint64 current, Uint64 value) {
+	return current == 0 ? value : std::min(current, value);
+}
+
+void KeyboardAnalyzer::handle_event(const SDL_Event &event) {
+	if (event.type != SDL_EVENT_KEY_DOWN && event.type != SDL_EVENT_KEY_UP) {
+		return;
+	}
+	// Repeats are made up by the OS, not the keyboard.
+	if (event.key.repeat) {
+		return;
+	}
+	const SDL_Scancode scancode = event.key.scancode;
+	if (scancode < 0 || scancode >= SDL_SCANCODE_COUNT) {
+		return;
+	}
+	const bool was_down = m_state.is_down(scancode);
+	m_state.handle_event(event);
+
+	KeyPressStats &stats = m_keys[scancode];
+	const Uint64 timestamp = event.key.timestamp;
+	if (event.key.down && !was_down) {
+		++stats.presses;
+		++m_presses;
+		if (stats.last_release_ns != 0 && timestamp >= stats.last_release_ns) {
+			const Uint64 gap = timestamp - stats.last_release_ns;
+			stats.min_gap_ns = min_nonzero(stats.min_gap_ns, gap);
+			if (gap < CHATTER_GAP_NS) {
+				++stats.chatter;
+				++m_chatter;
+			}
+		}
+		stats.last_press_ns = timestamp;
+		m_max_rollover = std::max(m_max_rollover, m_state.count());
+	} else if (!event.key.down && was_down) {
+		if (stats.last_press_ns != 0 && timestamp >= stats.last_press_ns) {
+			const Uint64 hold = timestamp - stats.last_press_ns;
+			stats.min_hold_ns = min_nonzero(stats.min_hold_ns, hold);
+			m_hold_times.add(hold / 1000);
+		}
+		stats.last_release_ns = timestamp;
+	}
+}
+
+void KeyboardAnalyzer::clear() {
+	*this = KeyboardAnalyzer();
+}
+
+void KeyboardAnalyzer::write_csv(std::ostream &out) const {
+	out << "scancode,name,presses,chatter,min_hold_ms,min_gap_ms" << std::endl;
+	out << std::fixed << std::setprecision(3);
+	for (int scancode = 0; scancode < SDL_SCANCODE_COUNT; ++scancode) {
+		const KeyPressStats &stats = m_keys[scancode];
+		if (stats.presses == 0) {
+			continue;
+		}
+		out << scancode << ",";
+		write_csv_text(out, SDL_GetScancodeName(static_cast<SDL_Scancode>(scancode)));
+		out << ","
+			<< stats.presses << ","
+			<< stats.chatter << ","
+			<< stats.min_hold_ns / 1e6 << ","
+			<< stats.min_gap_ns / 1e6
+			<< std::endl;
+	}
+}
+
+} // namespace robikzinputtest
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "histogram.hpp"
+
+#include <SDL3/SDL.h>
+
+#include <array>
+#include <bitset>
+#include <cstdint>
+#include <ostream>
+
+namespace robikzinputtest {
+
+using KeySet = std::bitset<SDL_SCANCODE_COUNT>;
+
+/**
+ * Which keys are held, by scancode.
+ */
+class KeyboardState {
+public:
+	/// Apply the key event; return false if it's not a key event.
+	bool handle_event(const SDL_Event &event);
+	void clear() { m_down.reset(); }
+
+	bool is_down(SDL_Scancode scancode) const { return m_down.test(scancode); }
+	/// Is any of the keys held.
+	bool any_down(const KeySet &keys) const { return (m_down & keys).any(); }
+	size_t count() const { return m_down.count(); }
+	const KeySet &keys() const { return m_down; }
+
+private:
+	KeySet m_down;
+};
+
+/**
+ * Press statistics of a single key. Times are in SDL_GetTicksNS() nanoseconds.
+ */
+struct KeyPressStats {
+	uint32_t presses = 0;
+	/// Presses that came too soon after a release to be made by a finger.
+	uint32_t chatter = 0;
+	/// Shortest time the key was held.
+	Uint64 min_hold_ns = 0;
+	/// Shortest time between a release and the next press.
+	Uint64 min_gap_ns = 0;
+
+	Uint64 last_press_ns = 0;
+	Uint64 last_release_ns = 0;
+};
+
+/**
+ * Analysis of the keyboard: key chatter, debounce time and rollover.
+ *
+ * Chatter is a press that follows the previous release of the key
+ * within CHATTER_GAP_NS. The shortest hold times hint at the keyboard's
+ * debounce time. The rollover is the most keys held at once; a keyboard
+ * without N-key rollover stops reporting new keys past its limit.
+ */
+class KeyboardAnalyzer {
+public:
+	static constexpr Uint64 CHATTER_GAP_NS = 20'000'000;
+
+	void handle_event(const SDL_Event &event);
+	void clear();
+
+	const KeyboardState &state() const { return m_state; }
+	const KeyPressStats &key(SDL_Scancode scancode) const { return m_keys[scancode]; }
+	/// Most keys that were held at once.
+	size_t max_rollover() const { return m_max_rollover; }
+	uint64_t presses() const { return m_presses; }
+	uint64_t chatter() const { return m_chatter; }
+	/// Hold times of all keys, in microseconds.
+	const Histogram &hold_times() const { return m_hold_times; }
+
+	/// Write the per-key statistics as CSV.
+	void write_csv(std::ostream &out) const;
+
+private:
+	KeyboardState m_state;
+	std::array<KeyPressStats, SDL_SCANCODE_COUNT> m_keys {};
+	size_t m_max_rollover = 0;
+	uint64_t m_presses = 0;
+	uint64_t m_chatter = 0;
+	Histogram m_hold_times;
+};
+
+} // namespace robikzinputtest
@@ -0,0 +1,42 @@
+#include "latency_tracker.hpp"
+
+namespace robikzinputtest {
+
+void LatencyTracker::add_input(Uint64 timestamp_ns) {
+	if (m_pending_ns == 0 || timestamp_ns < m_pending_ns) {
+		m_pending_ns = timestamp_ns;
+	}
+}
+
+bool LatencyTracker::presented(Uint64 present_ns) {
+	if (m_pending_ns == 0) {
+		return false;
+	}
+	const bool measured = present_ns >= m_pending_ns;
+	if (measured) {
+		m_last_us = (present_ns - m_pending_ns) / 1000;
+		m_latencies.add(m_last_us);
+	}
+	m_pending_ns = 0;
+	return measured;
+}
+
+void LatencyTracker::clear() {
+	*this = LatencyTracker();
+}
+
+LatencyReport LatencyTracker::report() const {
+	LatencyReport report;
+	report.frames = m_latencies.count();
+	if (report.frames == 0) {
+		return report;
+	}
+	report.last_us = m_last_us;
+	report.p50_us = m_latencies.percentile(0.50);
+	report.p90_us = m_latencies.percentile(0.90);
+	report.p99_us = m_latencies.percentile(0.99);
+	report.max_us = m_latencies.max();
+	return report;
+}
+
+} // namespace robikzinputtest
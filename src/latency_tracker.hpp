@@ -0,0 +1,54 @@
+#pragma once
+
+#include "histogram.hpp"
+
+#include <SDL3/SDL.h>
+
+#include <cstdint>
+
+namespace robikzinputtest {
+
+/**
+ * Summary of the measured latencies, in microseconds.
+ */
+struct LatencyReport {
+	/// Number of presented frames that carried input.
+	uint64_t frames = 0;
+	uint64_t last_us = 0;
+	uint64_t p50_us = 0;
+	uint64_t p90_us = 0;
+	uint64_t p99_us = 0;
+	uint64_t max_us = 0;
+};
+
+/**
+ * Measure the time from an input event to the present of the frame
+ * that displays it.
+ *
+ * Only the oldest input of each frame is measured, as that's the one
+ * that waited the longest.
+ */
+class LatencyTracker {
+public:
+	/// Input timestamped in SDL_GetTicksNS() nanoseconds was handled.
+	void add_input(Uint64 timestamp_ns);
+	/**
+	 * The frame with all the handled input was presented at the given
+	 * SDL_GetTicksNS(). Returns true if it carried input, whose latency
+	 * is then last_us().
+	 */
+	bool presented(Uint64 present_ns);
+	void clear();
+
+	LatencyReport report() const;
+	/// Latency of the last presented frame that carried input.
+	uint64_t last_us() const { return m_last_us; }
+
+private:
+	Histogram m_latencies;
+	/// Timestamp of the oldest input not yet presented; 0 if none.
+	Uint64 m_pending_ns = 0;
+	uint64_t m_last_us = 0;
+};
+
+} // namespace robikzinputtest
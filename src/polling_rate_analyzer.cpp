@@ -0,0 +1,112 @@
+#include "polling_rate_analyzer.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace robikzinputtest {
+
+/// Gaps this many nominal intervals long or longer aren't missed reports but idleness.
+static constexpr double MISSING_GAP_INTERVALS_MAX = 4.0;
+
+void PollingRateAnalyzer::add_event(const SDL_Event &event) {
+	switch (event.type) {
+	case SDL_EVENT_JOYSTICK_AXIS_MOTION:
+		add(event.jaxis.timestamp, axis_control(event.jaxis.axis));
+		break;
+	case SDL_EVENT_JOYSTICK_HAT_MOTION:
+		add(event.jhat.timestamp, hat_control(event.jhat.hat));
+		break;
+	case SDL_EVENT_JOYSTICK_BUTTON_DOWN:
+	case SDL_EVENT_JOYSTICK_BUTTON_UP:
+		add(event.jbutton.timestamp, button_control(event.jbutton.button));
+		break;
+	case SDL_EVENT_MOUSE_MOTION:
+		add(event.motion.timestamp, mouse_motion_control());
+		break;
+	case SDL_EVENT_MOUSE_WHEEL:
+		add(event.wheel.timestamp, mouse_wheel_control());
+		break;
+	case SDL_EVENT_MOUSE_BUTTON_DOWN:
+	case SDL_EVENT_MOUSE_BUTTON_UP:
+		add(event.button.timestamp, button_control(event.button.button));
+		break;
+	default:
+		break;
+	}
+}
+
+void PollingRateAnalyzer::add(Uint64 timestamp_ns, int control) {
+	if (control < 0 || control >= MAX_CONTROLS) {
+		return;
+	}
+	if (m_reports > 0 && timestamp_ns == m_last_timestamp_ns) {
+		// Same report; unless the control was already in it.
+		if (m_report_controls.test(control)) {
+			++m_duplicates;
+		}
+		m_report_controls.set(control);
+		return;
+	}
+	if (m_reports > 0 && timestamp_ns > m_last_timestamp_ns) {
+		const uint64_t interval_us = (timestamp_ns - m_last_timestamp_ns) / 1000;
+		if (interval_us < IDLE_INTERVAL_US) {
+			m_intervals.add(interval_us);
+			const double interval = static_cast<double>(interval_us);
+			m_interval_sum_us += interval;
+			m_interval_sum_squares_us += interval * interval;
+		}
+	}
+	++m_reports;
+	m_last_timestamp_ns = timestamp_ns;
+	m_report_controls.reset();
+	m_report_controls.set(control);
+}
+
+void PollingRateAnalyzer::clear() {
+	*this = PollingRateAnalyzer();
+}
+
+PollingRateReport PollingRateAnalyzer::report() const {
+	PollingRateReport report;
+	report.reports = m_reports;
+	report.duplicates = m_duplicates;
+
+	const uint64_t n_intervals = m_intervals.count();
+	if (n_intervals == 0) {
+		return report;
+	}
+	report.interval_min_us = m_intervals.min();
+	report.interval_p50_us = m_intervals.percentile(0.50);
+	report.interval_p90_us = m_intervals.percentile(0.90);
+	report.interval_p99_us = m_intervals.percentile(0.99);
+	report.interval_max_us = m_intervals.max();
+
+	const double mean_us = m_interval_sum_us / static_cast<double>(n_intervals);
+	const double variance = m_interval_sum_squares_us / static_cast<double>(n_intervals) - mean_us * mean_us;
+	report.jitter_us = std::sqrt(std::max(0.0, variance));
+	if (mean_us > 0.0) {
+		report.mean_rate_hz = 1e6 / mean_us;
+	}
+
+	const double period_us = static_cast<double>(report.interval_p50_us);
+	if (period_us <= 0.0) {
+		return report;
+	}
+	report.rate_hz = 1e6 / period_us;
+	// A gap of a few periods in an otherwise steady stream means
+	// the reports in-between got lost.
+	for (int index = 0; index < Histogram::BUCKET_COUNT; ++index) {
+		const uint32_t count = m_intervals.bucket_count(index);
+		if (count == 0)
+			continue;
+		const double intervals = static_cast<double>(Histogram::bucket_midpoint(index)) / period_us;
+		if (intervals < 1.5)
+			continue;
+		if (intervals >= MISSING_GAP_INTERVALS_MAX)
+			break;
+		report.missing += count * static_cast<uint64_t>(std::llround(intervals) - 1);
+	}
+	return report;
+}
+
+} // namespace robikzinputtest
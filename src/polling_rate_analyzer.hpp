@@ -0,0 +1,84 @@
+#pragma once
+
+#include "histogram.hpp"
+
+#include <SDL3/SDL.h>
+
+#include <bitset>
+#include <cstdint>
+
+namespace robikzinputtest {
+
+/**
+ * Summary of the analyzed device reports.
+ *
+ * Intervals are in microseconds.
+ */
+struct PollingRateReport {
+	/// Reports seen; events sharing a timestamp make one report.
+	uint64_t reports = 0;
+	/// Reports that repeated a control already reported at the same timestamp.
+	uint64_t duplicates = 0;
+	/// Estimated reports missing from the gaps in a steady stream.
+	uint64_t missing = 0;
+
+	/// Report rate derived from the median interval.
+	double rate_hz = 0.0;
+	/// Report rate derived from the mean interval.
+	double mean_rate_hz = 0.0;
+	/// Standard deviation of the interval.
+	double jitter_us = 0.0;
+
+	uint64_t interval_min_us = 0;
+	uint64_t interval_p50_us = 0;
+	uint64_t interval_p90_us = 0;
+	uint64_t interval_p99_us = 0;
+	uint64_t interval_max_us = 0;
+};
+
+/**
+ * Measure how often a device reports its state, from the timestamps
+ * of its SDL events.
+ *
+ * SDL sends events only when a control changes, so the device is silent
+ * when not handled. Intervals longer than IDLE_INTERVAL_US are treated
+ * as idleness and not analyzed.
+ */
+class PollingRateAnalyzer {
+public:
+	static constexpr uint64_t IDLE_INTERVAL_US = 100'000;
+	static constexpr int MAX_CONTROLS = 768;
+
+	/// Key of a control, unique within the device.
+	static int axis_control(int axis) { return axis; }
+	static int hat_control(int hat) { return 256 + hat; }
+	static int button_control(int button) { return 512 + button; }
+	/// Mouse motion reports both axes at once.
+	static int mouse_motion_control() { return axis_control(0); }
+	static int mouse_wheel_control() { return axis_control(1); }
+
+	/**
+	 * Account the event of the device. Events of unsupported type are ignored.
+	 */
+	void add_event(const SDL_Event &event);
+	/**
+	 * Account a report of the control, timestamped in SDL_GetTicksNS() nanoseconds.
+	 */
+	void add(Uint64 timestamp_ns, int control);
+	void clear();
+
+	PollingRateReport report() const;
+
+private:
+	Histogram m_intervals;
+	uint64_t m_reports = 0;
+	uint64_t m_duplicates = 0;
+	Uint64 m_last_timestamp_ns = 0;
+	/// Controls seen in the report at m_last_timestamp_ns.
+	std::bitset<MAX_CONTROLS> m_report_controls;
+
+	double m_interval_sum_us = 0.0;
+	double m_interval_sum_squares_us = 0.0;
+};
+
+} // namespace robikzinputtest
@@ -0,0 +1,148 @@
+#include "present_timing.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace robikzinputtest {
+
+/// Value below which the fraction of the samples falls.
+static float percentile(const RingBuffer<float, PresentTiming::WINDOW> &samples, double fraction) {
+	std::array<float, PresentTiming::WINDOW> sorted;
+	const size_t count = samples.size();
+	if (count == 0) {
+		return 0.0f;
+	}
+	for (size_t i = 0; i < count; ++i) {
+		sorted[i] = samples[i];
+	}
+	const size_t nth = std::min(count - 1, static_cast<size_t>(fraction * static_cast<double>(count)));
+	std::nth_element(sorted.begin(), sorted.begin() + nth, sorted.begin() + count);
+	return sorted[nth];
+}
+
+void PresentTiming::expect(int vsync, int refresh_numerator, int refresh_denominator) {
+	m_vsync = vsync;
+	m_period_ns = refresh_numerator > 0 && refresh_denominator > 0
+		? 1e9 * static_cast<double>(refresh_denominator) / static_cast<double>(refresh_numerator)
+		: 0.0;
+	clear();
+}
+
+void PresentTiming::clear() {
+	m_call_ms.clear();
+	m_interval_ms.clear();
+	m_last_present_ns = 0;
+	m_presents = 0;
+	m_quick_run = 0;
+	m_quick_run_max = 0;
+	m_after_stall = true;
+	m_report = {};
+	m_report.refresh_period_ms = m_period_ns / 1e6;
+}
+
+bool PresentTiming::presented(Uint64 submit_ns, Uint64 present_ns) {
+	const Uint64 call_ns = present_ns - submit_ns;
+	m_call_ms.push(static_cast<float>(static_cast<double>(call_ns) / 1e6));
+	if (m_last_present_ns != 0) {
+		const Uint64 interval_ns = present_ns - m_last_present_ns;
+		m_interval_ms.push(static_cast<float>(static_cast<double>(interval_ns) / 1e6));
+		// A long gap, e.g. a window drag, lets the driver's queue drain.
+		if (m_period_ns > 0.0 && static_cast<double>(interval_ns) > STALL_PERIODS * m_period_ns) {
+			m_after_stall = true;
+			m_quick_run = 0;
+		}
+	}
+	m_last_present_ns = present_ns;
+
+	// After a drain, the presents return at once until the queue is full again.
+	if (m_period_ns > 0.0 && m_after_stall) {
+		if (static_cast<double>(call_ns) < BLOCKING_FRACTION * m_period_ns) {
+			++m_quick_run;
+		} else {
+			m_quick_run_max = std::max(m_quick_run_max, m_quick_run);
+			m_quick_run = 0;
+			m_after_stall = false;
+		}
+	}
+
+	++m_presents;
+	if (m_presents % EVALUATE_EVERY != 0) {
+		return false;
+	}
+	evaluate();
+	return true;
+}
+
+void PresentTiming::evaluate() {
+	PresentTimingReport &report = m_report;
+	report.call_p50_ms = percentile(m_call_ms, 0.5);
+	report.call_p99_ms = percentile(m_call_ms, 0.99);
+	report.interval_p50_ms = percentile(m_interval_ms, 0.5);
+	report.interval_p99_ms = percentile(m_interval_ms, 0.99);
+	report.refresh_period_ms = m_period_ns / 1e6;
+	if (m_quick_run_max > 0) {
+		report.queued_frames = m_quick_run_max;
+		m_quick_run_max = 0;
+	}
+
+	report.observed = ObservedVsync::UNKNOWN;
+	report.interval = 0;
+	report.mismatch = false;
+	if (m_period_ns <= 0.0 || m_interval_ms.size() < EVALUATE_EVERY) {
+		return;
+	}
+
+	const double period_ms = report.refresh_period_ms;
+	size_t on_grid = 0;
+	for (size_t i = 0; i < m_interval_ms.size(); ++i) {
+		const double periods = m_interval_ms[i] / period_ms;
+		const double multiple = std::round(periods);
+		if (multiple >= 1.0 && std::abs(periods - multiple) <= GRID_TOLERANCE) {
+			++on_grid;
+		}
+	}
+	size_t blocking = 0;
+	for (size_t i = 0; i < m_call_ms.size(); ++i) {
+		if (m_call_ms[i] >= BLOCKING_FRACTION * period_ms) {
+			++blocking;
+		}
+	}
+
+	const double on_grid_fraction = static_cast<double>(on_grid) / static_cast<double>(m_interval_ms.size());
+	if (
+		report.interval_p50_ms < (1.0 - GRID_TOLERANCE) * period_ms
+		|| on_grid_fraction < GRID_MIN_FRACTION
+	) {
+		report.observed = ObservedVsync::UNSYNCED;
+	} else {
+		report.interval = std::max(1, static_cast<int>(std::lround(report.interval_p50_ms / period_ms)));
+		report.observed = blocking * 2 >= m_call_ms.size()
+			? ObservedVsync::SYNCED
+			: ObservedVsync::PACED;
+	}
+
+	// Adaptive vsync is allowed to tear when late, so any behavior fits it.
+	if (m_vsync == 0) {
+		report.mismatch = report.observed == ObservedVsync::SYNCED;
+	} else if (m_vsync > 0) {
+		report.mismatch = report.observed == ObservedVsync::UNSYNCED
+			|| (report.observed == ObservedVsync::SYNCED && report.interval < m_vsync);
+	}
+}
+
+const char *observed_vsync_label(ObservedVsync observed) {
+	switch (observed) {
+	case ObservedVsync::UNKNOWN:
+		return "UNKNOWN";
+	case ObservedVsync::UNSYNCED:
+		return "UNSYNCED";
+	case ObservedVsync::PACED:
+		return "PACED";
+	case ObservedVsync::SYNCED:
+		return "SYNCED";
+	}
+	return "UNKNOWN";
+}
+
+} // namespace robikzinputtest
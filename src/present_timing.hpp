@@ -0,0 +1,115 @@
+#pragma once
+
+#include "ring_buffer.hpp"
+
+#include <SDL3/SDL.h>
+
+#include <cstdint>
+
+namespace robikzinputtest {
+
+/**
+ * How the presents were seen to behave, whatever vsync was asked for.
+ */
+enum class ObservedVsync {
+	/// Too few presents, or no known refresh rate.
+	UNKNOWN,
+	/// Presents come faster than the refresh rate, or off its grid.
+	UNSYNCED,
+	/// Presents land on the refresh grid, but the present call doesn't
+	/// wait; the app paces itself, so vsync can't be told apart.
+	PACED,
+	/// Presents land on the refresh grid and the present call waits.
+	SYNCED,
+};
+
+/**
+ * Summary of the present timing over the recent frames.
+ */
+struct PresentTimingReport {
+	ObservedVsync observed = ObservedVsync::UNKNOWN;
+	/// Refreshes per present when synced or paced.
+	int interval = 0;
+	/// Most presents seen to return at once in a row when synced:
+	/// the frames the driver takes ahead before it makes the app wait.
+	int queued_frames = 0;
+	/// The configured vsync disagrees with the observed behavior.
+	bool mismatch = false;
+	double call_p50_ms = 0.0;
+	double call_p99_ms = 0.0;
+	double interval_p50_ms = 0.0;
+	double interval_p99_ms = 0.0;
+	double refresh_period_ms = 0.0;
+};
+
+/**
+ * Time SDL_RenderPresent() and the interval between its returns, and
+ * estimate from them what the driver actually does with vsync.
+ *
+ * With vsync, a present returns on the refresh grid and, once the
+ * driver's queue is full, the call itself waits for a refresh. Without
+ * it, the presents return at once and their interval follows the app.
+ * An app that paces itself to the refresh rate looks like vsync with
+ * a queue that never fills; that's reported as such and not flagged.
+ */
+class PresentTiming {
+public:
+	/// Frames the estimate looks back over.
+	static constexpr size_t WINDOW = 120;
+	/// Frames between the estimates.
+	static constexpr uint64_t EVALUATE_EVERY = 30;
+	/// Distance from a multiple of the refresh period still on the grid.
+	static constexpr double GRID_TOLERANCE = 0.15;
+	/// Fraction of the intervals that must be on the grid.
+	static constexpr double GRID_MIN_FRACTION = 0.75;
+	/// A present call that took this fraction of a refresh has waited.
+	static constexpr double BLOCKING_FRACTION = 0.125;
+	/// Presents apart by more than this many refreshes are a stall.
+	static constexpr double STALL_PERIODS = 4.0;
+
+	/**
+	 * The vsync asked of the renderer and the refresh rate of the
+	 * window's display; 0 numerator if it's unknown. Starts over.
+	 */
+	void expect(int vsync, int refresh_numerator, int refresh_denominator);
+
+	/**
+	 * The present started at submit_ns and returned at present_ns.
+	 * Returns true when the report was updated.
+	 */
+	bool presented(Uint64 submit_ns, Uint64 present_ns);
+	void clear();
+
+	const PresentTimingReport &report() const { return m_report; }
+	int configured_vsync() const { return m_vsync; }
+
+	/// Present call durations in ms, for plotting.
+	const RingBuffer<float, WINDOW> &call_ms() const { return m_call_ms; }
+	/// Intervals between the present returns in ms, for plotting.
+	const RingBuffer<float, WINDOW> &interval_ms() const { return m_interval_ms; }
+
+private:
+	int m_vsync = 0;
+	double m_period_ns = 0.0;
+
+	RingBuffer<float, WINDOW> m_call_ms;
+	RingBuffer<float, WINDOW> m_interval_ms;
+	Uint64 m_last_present_ns = 0;
+	uint64_t m_presents = 0;
+
+	/// Presents that returned at once since the last one that waited.
+	int m_quick_run = 0;
+	/// Longest such run since the estimate before.
+	int m_quick_run_max = 0;
+	/// The queue drained, so the next quick presents refill it.
+	bool m_after_stall = false;
+
+	PresentTimingReport m_report;
+
+	void evaluate();
+};
+
+/// Short name of the observed vsync.
+const char *observed_vsync_label(ObservedVsync observed);
+
+} // namespace robikzinputtest
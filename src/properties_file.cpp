@@ -2,48 +2,58 @@
 
 #include "text.hpp"
 
-#include <algorithm>
-#include <sstream>
-
 namespace robikzinputtest {
 
-std::vector<Property> read_properties(std::string rawfile) {
-	std::vector<Property> properties;
-	std::istringstream iss(rawfile);
-	std::string line;
+std::vector<PropertyView> parse_properties(std::string_view text) {
+	std::vector<PropertyView> properties;
+	while (!text.empty()) {
+		const size_t line_end = text.find('\n');
+		const std::string_view line = text.substr(0, line_end);
+		text.remove_prefix(line_end == std::string_view::npos ? text.size() : line_end + 1);
 
-	while (std::getline(iss, line)) {
-		if (line.empty())
-			continue;
-		auto equal_pos = line.find('=');
-		if (equal_pos == std::string::npos)
+		const size_t equal_pos = line.find('=');
+		if (equal_pos == std::string_view::npos)
 			continue;
 
-		std::string name = text::trim(line.substr(0, equal_pos));
-		std::string value = text::trim(line.substr(equal_pos + 1));
-
-		std::transform(
-			name.begin(), name.end(), name.begin(),
-			[](char c) { return std::tolower(c); }
-		);
-
-		properties.push_back({ name, value });
+		properties.push_back({
+			text::trim_view(line.substr(0, equal_pos)),
+			text::trim_view(line.substr(equal_pos + 1)),
+		});
 	}
+	return properties;
+}
 
+std::vector<Property> read_properties(std::string_view rawfile) {
+	const std::vector<PropertyView> views = parse_properties(rawfile);
+	std::vector<Property> properties;
+	properties.reserve(views.size());
+	for (const PropertyView &view : views) {
+		std::string name(view.name);
+		for (char &c : name) {
+			c = text::ascii_tolower(c);
+		}
+		properties.push_back({ std::move(name), Variant(view.value) });
+	}
 	return properties;
 }
 
-std::string write_properties(std::vector<Property> properties) {
-	std::stringstream ss;
+std::string write_properties(const std::vector<Property> &properties) {
+	size_t size = 0;
+	for (const Property &property : properties) {
+		// name=value\n
+		size += property.name.size() + property.value.text_size_max() + 2;
+	}
+	std::string text;
+	text.reserve(size);
 	for (const Property &property : properties) {
-		std::string lowername(property.name.size(), '\0');
-		std::transform(
-			property.name.begin(), property.name.end(), lowername.begin(),
-			[](char c) { return std::tolower(c); }
-		);
-		ss << lowername << "=" << property.value.as_string() << std::endl;
+		for (char c : property.name) {
+			text.push_back(text::ascii_tolower(c));
+		}
+		text.push_back('=');
+		property.value.append_to(text);
+		text.push_back('\n');
 	}
-	return ss.str();
+	return text;
 }
 
 } // namespace robikzinputtest
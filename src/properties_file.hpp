@@ -3,6 +3,7 @@
 #include "variant.hpp"
 
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace robikzinputtest {
@@ -12,7 +13,20 @@ struct Property {
 	Variant value;
 };
 
-std::vector<Property> read_properties(std::string rawfile);
-std::string write_properties(std::vector<Property> properties);
+/**
+ * A property as it is in the text, trimmed; both views point into
+ * the parsed text, which must outlive them. The name keeps its case.
+ */
+struct PropertyView {
+	std::string_view name;
+	std::string_view value;
+};
+
+/// Parse the `name=value` lines in one pass, without copying the text.
+std::vector<PropertyView> parse_properties(std::string_view text);
+/// Parse into owned properties with lowercase names.
+std::vector<Property> read_properties(std::string_view rawfile);
+/// Write the properties into one buffer sized up front.
+std::string write_properties(const std::vector<Property> &properties);
 
 } // namespace robikzinputtest
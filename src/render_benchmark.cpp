@@ -0,0 +1,167 @@
+#include "render_benchmark.hpp"
+
+#include "histogram.hpp"
+#include "sdl_virtual_joystick.hpp"
+
+#include <cmath>
+#include <iomanip>
+#include <vector>
+
+namespace robikzinputtest {
+
+static const int SCRIPT_BUTTON = 0;
+static const int SCRIPT_AXIS_X = 0;
+static const int SCRIPT_AXIS_Y = 1;
+/// Frames of one turn of the circle the gizmo sweeps.
+static const int SCRIPT_CIRCLE_FRAMES = 240;
+/// Frames the button stays pressed, then released.
+static const int SCRIPT_BUTTON_FRAMES = 30;
+static const float SCRIPT_AXIS_AMPLITUDE = 0.8f * SDL_JOYSTICK_AXIS_MAX;
+
+/// Measurements of one render driver, in microseconds.
+struct DriverResult {
+	std::string name;
+	bool failed = false;
+	/// From the start of the frame to its submit: the CPU cost.
+	Histogram frame_us;
+	/// The present call.
+	Histogram present_us;
+	/// Between the present returns.
+	Histogram interval_us;
+	Uint64 last_present_ns = 0;
+};
+
+struct RenderBenchmark::D {
+	int frames;
+	std::unique_ptr<sdl::VirtualJoystick> joystick;
+
+	std::vector<DriverResult> drivers;
+	/// The driver being measured; -1 before the first.
+	int current = -1;
+	/// Frame of the script on the current driver.
+	int frame = 0;
+
+	D(int frames) : frames(frames) {}
+
+	bool current_done() const {
+		return current < 0
+			|| drivers[current].failed
+			|| frame >= WARMUP_FRAMES + frames;
+	}
+};
+
+RenderBenchmark::RenderBenchmark(int frames)
+	: d(std::make_unique<D>(frames)) {
+	const int driver_count = SDL_GetNumRenderDrivers();
+	for (int i = 0; i < driver_count; ++i) {
+		DriverResult result;
+		result.name = SDL_GetRenderDriver(i);
+		d->drivers.push_back(std::move(result));
+	}
+
+	SDL_VirtualJoystickDesc desc;
+	SDL_INIT_INTERFACE(&desc);
+	desc.type = SDL_JOYSTICK_TYPE_UNKNOWN;
+	desc.naxes = SCRIPT_AXIS_Y + 1;
+	desc.nbuttons = SCRIPT_BUTTON + 1;
+	desc.name = "Render Benchmark Joystick";
+	d->joystick = std::make_unique<sdl::VirtualJoystick>(desc);
+}
+
+RenderBenchmark::~RenderBenchmark() = default;
+
+bool RenderBenchmark::valid() const {
+	return d->joystick->valid() && !d->drivers.empty();
+}
+
+bool RenderBenchmark::is_finished() const {
+	return d->current + 1 >= static_cast<int>(d->drivers.size()) && d->current_done();
+}
+
+SDL_JoystickID RenderBenchmark::joystick_id() const {
+	return d->joystick->id();
+}
+
+bool RenderBenchmark::needs_driver() const {
+	return !is_finished() && d->current_done();
+}
+
+std::string RenderBenchmark::next_driver() {
+	++d->current;
+	d->frame = 0;
+	return d->drivers[d->current].name;
+}
+
+void RenderBenchmark::driver_failed() {
+	if (d->current >= 0) {
+		d->drivers[d->current].failed = true;
+	}
+}
+
+void RenderBenchmark::begin_frame() {
+	if (d->current_done()) {
+		return;
+	}
+	const float angle = 2.0f * SDL_PI_F * static_cast<float>(d->frame % SCRIPT_CIRCLE_FRAMES) / SCRIPT_CIRCLE_FRAMES;
+	d->joystick->set_axis(SCRIPT_AXIS_X, static_cast<Sint16>(SCRIPT_AXIS_AMPLITUDE * std::cos(angle)));
+	d->joystick->set_axis(SCRIPT_AXIS_Y, static_cast<Sint16>(SCRIPT_AXIS_AMPLITUDE * std::sin(angle)));
+	// The first press spawns the gizmo.
+	d->joystick->set_button(SCRIPT_BUTTON, (d->frame / SCRIPT_BUTTON_FRAMES) % 2 == 0);
+}
+
+void RenderBenchmark::frame_presented(Uint64 frame_ns, Uint64 submit_ns, Uint64 present_ns) {
+	if (d->current_done()) {
+		return;
+	}
+	DriverResult &result = d->drivers[d->current];
+	if (d->frame >= WARMUP_FRAMES) {
+		result.frame_us.add((submit_ns - frame_ns) / 1000);
+		result.present_us.add((present_ns - submit_ns) / 1000);
+		if (result.last_present_ns != 0) {
+			result.interval_us.add((present_ns - result.last_present_ns) / 1000);
+		}
+	}
+	result.last_present_ns = present_ns;
+	++d->frame;
+}
+
+bool RenderBenchmark::write_summary(std::ostream &out) const {
+	auto ms = [](uint64_t us) {
+		return static_cast<double>(us) / 1000.0;
+	};
+	out << "Render benchmark: " << d->frames << " frames per driver, "
+		<< WARMUP_FRAMES << " warm-up frames" << std::endl;
+	out << std::left << std::setw(12) << "driver"
+		<< std::right
+		<< std::setw(10) << "fps"
+		<< std::setw(10) << "frame50"
+		<< std::setw(10) << "frame99"
+		<< std::setw(10) << "present50"
+		<< std::setw(10) << "present99"
+		<< std::setw(10) << "max"
+		<< std::endl;
+	bool measured = false;
+	for (const DriverResult &result : d->drivers) {
+		out << std::left << std::setw(12) << result.name << std::right;
+		if (result.failed || result.frame_us.count() == 0) {
+			out << std::setw(10) << "failed" << std::endl;
+			continue;
+		}
+		measured = true;
+		const uint64_t interval_p50_us = result.interval_us.percentile(0.50);
+		out << std::fixed << std::setprecision(1)
+			<< std::setw(10) << (interval_p50_us > 0 ? 1e6 / static_cast<double>(interval_p50_us) : 0.0)
+			<< std::setprecision(3)
+			<< std::setw(10) << ms(result.frame_us.percentile(0.50))
+			<< std::setw(10) << ms(result.frame_us.percentile(0.99))
+			<< std::setw(10) << ms(result.present_us.percentile(0.50))
+			<< std::setw(10) << ms(result.present_us.percentile(0.99))
+			<< std::setw(10) << ms(result.interval_us.max())
+			<< std::endl;
+	}
+	out << "Times in ms: frame is the CPU time up to the present, present is"
+		<< " the present call, max is the longest frame interval." << std::endl;
+	return measured;
+}
+
+} // namespace robikzinputtest
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+
+#include <memory>
+#include <ostream>
+#include <string>
+
+namespace robikzinputtest {
+
+/**
+ * Runs the same scripted scene on every available render driver and
+ * compares their frame times and present latencies.
+ *
+ * A virtual joystick spawns its gizmo, then sweeps it in a circle and
+ * toggles its button on a fixed frame schedule, so every driver draws
+ * the same frames. The script starts over on each driver; the first
+ * frames after a switch create the textures and aren't measured.
+ *
+ * The app recreates the renderer whenever the benchmark asks for
+ * the next driver, and runs without vsync and frame limit meanwhile.
+ */
+class RenderBenchmark {
+public:
+	static constexpr int WARMUP_FRAMES = 60;
+	static constexpr int DEFAULT_FRAMES = 600;
+
+	RenderBenchmark(int frames = DEFAULT_FRAMES);
+	~RenderBenchmark();
+
+	bool valid() const;
+	bool is_finished() const;
+	/// The virtual joystick that plays the script.
+	SDL_JoystickID joystick_id() const;
+
+	/// The measurements of the current driver are done.
+	bool needs_driver() const;
+	/// Move on to the next driver and return its name.
+	std::string next_driver();
+	/// The renderer of the current driver couldn't be made.
+	void driver_failed();
+
+	/// Play the script's input; call before the events are handled.
+	void begin_frame();
+	/**
+	 * Call right after the frame was presented, with when the frame
+	 * started, when it was submitted and when the present returned.
+	 */
+	void frame_presented(Uint64 frame_ns, Uint64 submit_ns, Uint64 present_ns);
+
+	/**
+	 * Write the table of the drivers.
+	 *
+	 * Return false if no driver was measured.
+	 */
+	bool write_summary(std::ostream &out) const;
+
+private:
+	struct D;
+	std::unique_ptr<D> d;
+};
+
+} // namespace robikzinputtest
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+namespace robikzinputtest {
+
+/**
+ * Fixed-capacity buffer that overwrites its oldest element when full.
+ *
+ * The storage is laid out so that data() with offset() can be passed to
+ * ImGui::PlotLines() directly.
+ */
+template <typename T, size_t N>
+class RingBuffer {
+public:
+	static constexpr size_t CAPACITY = N;
+
+	void push(const T &value) {
+		m_data[m_next] = value;
+		m_next = (m_next + 1) % N;
+		if (m_size < N) {
+			++m_size;
+		}
+	}
+
+	void clear() {
+		m_next = 0;
+		m_size = 0;
+	}
+
+	size_t size() const { return m_size; }
+	bool empty() const { return m_size == 0; }
+	bool full() const { return m_size == N; }
+
+	/// Element by age; 0 is the oldest.
+	const T &operator[](size_t index) const {
+		return m_data[(m_next + N - m_size + index) % N];
+	}
+
+	/// The newest element. The buffer must not be empty.
+	const T &back() const {
+		return m_data[(m_next + N - 1) % N];
+	}
+
+	/// Raw storage; the first size() elements from offset() are valid, wrapping around.
+	const T *data() const { return m_data.data(); }
+	/// Index of the oldest element in data().
+	size_t offset() const { return full() ? m_next : 0; }
+
+private:
+	std::array<T, N> m_data {};
+	size_t m_next = 0;
+	size_t m_size = 0;
+};
+
+} // namespace robikzinputtest
@@ -34,4 +34,22 @@ inline bool is_mouse_event(const SDL_Event &event)
 		;
 }
 
+/**
+ * The mouse that sent the event, or 0 if it's not a mouse event.
+ */
+inline SDL_MouseID get_mouse_event_which(const SDL_Event &event)
+{
+	switch (event.type) {
+	case SDL_EVENT_MOUSE_MOTION:
+		return event.motion.which;
+	case SDL_EVENT_MOUSE_BUTTON_DOWN:
+	case SDL_EVENT_MOUSE_BUTTON_UP:
+		return event.button.which;
+	case SDL_EVENT_MOUSE_WHEEL:
+		return event.wheel.which;
+	default:
+		return 0;
+	}
+}
+
 } // namespace robikzinputtest::sdl
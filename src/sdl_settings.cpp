@@ -9,30 +9,83 @@
 namespace robikzinputtest::sdl {
 
 static const std::string CONFIG_FILENAME = "robikzinputtest.cfg";
+/// A named profile is in "robikzinputtest.NAME.cfg".
+static const std::string PROFILE_FILENAME_PREFIX = "robikzinputtest.";
+static const std::string PROFILE_FILENAME_SUFFIX = ".cfg";
+static const std::string TEMP_FILENAME_SUFFIX = ".tmp";
+
+static std::string profile_filename(const std::string &profile) {
+	if (profile == SettingsProfiles::DEFAULT_PROFILE) {
+		return CONFIG_FILENAME;
+	}
+	return PROFILE_FILENAME_PREFIX + profile + PROFILE_FILENAME_SUFFIX;
+}
+
+SettingsSdlIO::SettingsSdlIO(std::string profile)
+	: m_filename(profile_filename(profile)) {
+}
 
 bool SettingsSdlIO::save(const Settings &settings) {
 	std::shared_ptr<SDL_Storage> storage = user_storage();
+	const std::string temp_filename = m_filename + TEMP_FILENAME_SUFFIX;
 
 	std::vector<Property> properties = settings.export_properties();
 	std::string text = write_properties(properties);
-	return write_text_file(storage, CONFIG_FILENAME, text);
+	// Write aside and move over the old file, so that a crash
+	// halfway through the write can't leave the config truncated.
+	if (!write_text_file(storage, temp_filename, text)) {
+		std::cerr << "Failed to write config file: " << temp_filename << std::endl;
+		return false;
+	}
+	if (!SDL_RenameStoragePath(storage.get(), temp_filename.c_str(), m_filename.c_str())) {
+		std::cerr << "Failed to replace config file: " << m_filename << ": " << SDL_GetError() << std::endl;
+		return false;
+	}
+	return true;
 }
 
 std::pair<bool, Settings> SettingsSdlIO::load() {
 	Settings settings;
 
 	std::shared_ptr<SDL_Storage> storage = user_storage();
-	auto file_load_result = load_text_file(storage, CONFIG_FILENAME);
+	auto file_load_result = load_text_file(storage, m_filename);
 	if (file_load_result.first) {
-		const std::vector<Property> properties =
-			read_properties(file_load_result.second);
+		const std::vector<PropertyView> properties =
+			parse_properties(file_load_result.second);
 		settings.import_properties(properties);
 		return { true, settings };
 	} else {
-		std::cerr << "Failed to read config file: " << CONFIG_FILENAME << std::endl;
+		std::cerr << "Failed to read config file: " << m_filename << std::endl;
 	}
 
 	return { false, settings };
 }
 
+std::vector<std::string> SettingsSdlIO::list_profiles() {
+	std::vector<std::string> profiles;
+	std::shared_ptr<SDL_Storage> storage = user_storage();
+	const std::string pattern = PROFILE_FILENAME_PREFIX + "*" + PROFILE_FILENAME_SUFFIX;
+	int count = 0;
+	char **filenames = SDL_GlobStorageDirectory(storage.get(), nullptr, pattern.c_str(), 0, &count);
+	if (filenames == nullptr) {
+		return profiles;
+	}
+	const size_t affixes = PROFILE_FILENAME_PREFIX.size() + PROFILE_FILENAME_SUFFIX.size();
+	for (int i = 0; i < count; ++i) {
+		const std::string filename = filenames[i];
+		if (filename.size() <= affixes) {
+			continue;
+		}
+		const std::string profile = filename.substr(
+			PROFILE_FILENAME_PREFIX.size(),
+			filename.size() - affixes
+		);
+		if (SettingsProfiles::is_valid_name(profile) && profile != SettingsProfiles::DEFAULT_PROFILE) {
+			profiles.push_back(profile);
+		}
+	}
+	SDL_free(filenames);
+	return profiles;
+}
+
 } // namespace robikzinputtest::sdl
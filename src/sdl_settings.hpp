@@ -1,13 +1,29 @@
 #pragma once
 
 #include "settings.hpp"
+#include "settings_profiles.hpp"
+
+#include <string>
+#include <vector>
 
 namespace robikzinputtest::sdl {
 
+/**
+ * Settings of a profile in the user storage. The default profile
+ * is the main config file; each named one has a file of its own.
+ */
 class SettingsSdlIO : public SettingsIO {
 public:
+	explicit SettingsSdlIO(std::string profile = SettingsProfiles::DEFAULT_PROFILE);
+
 	bool save(const Settings &settings) override;
 	std::pair<bool, Settings> load() override;
+
+	/// Names of the profiles that have a file, except the default one.
+	static std::vector<std::string> list_profiles();
+
+private:
+	std::string m_filename;
 };
 
 } // namespace robikzinputtest::sdl
@@ -2,13 +2,35 @@
 
 #include "SDL3/SDL_storage.h"
 #include "version.hpp"
+#include <algorithm>
 #include <iostream>
 
 namespace robikzinputtest::sdl {
 
+/// First sleep while waiting for the storage; doubled up to the longest one.
+static constexpr Uint64 STORAGE_WAIT_MIN_NS = 10'000;
+static constexpr Uint64 STORAGE_WAIT_MAX_NS = 1'000'000;
+/// Give up on a storage that doesn't get ready.
+static constexpr Uint64 STORAGE_READY_TIMEOUT_NS = 5'000'000'000;
+
 static std::shared_ptr<SDL_Storage> await_ready(std::shared_ptr<SDL_Storage> storage) {
-	while (!SDL_StorageReady(storage.get()))
-		SDL_Delay(1);
+	if (!storage) {
+		std::cerr << "Failed to open user storage: " << SDL_GetError() << std::endl;
+		return storage;
+	}
+	// A local storage is ready right away. Others are polled with
+	// a short sleep growing longer, so one that gets ready soon
+	// isn't waited on for a whole millisecond.
+	const Uint64 deadline_ns = SDL_GetTicksNS() + STORAGE_READY_TIMEOUT_NS;
+	Uint64 wait_ns = STORAGE_WAIT_MIN_NS;
+	while (!SDL_StorageReady(storage.get())) {
+		if (SDL_GetTicksNS() >= deadline_ns) {
+			std::cerr << "User storage is not ready" << std::endl;
+			return nullptr;
+		}
+		SDL_DelayNS(wait_ns);
+		wait_ns = std::min(wait_ns * 2, STORAGE_WAIT_MAX_NS);
+	}
 	return storage;
 }
 
@@ -43,7 +65,7 @@ std::pair<bool, std::vector<uint8_t>> load_binary_file(
 				file_len
 			)
 		) {
-			return { true, buffer };
+			return { true, std::move(buffer) };
 		} else {
 			std::cerr << "Failed to read user file: " << name << std::endl;;
 			return { false, {} };
@@ -58,13 +80,17 @@ std::pair<bool, std::string> load_text_file(
 	std::shared_ptr<SDL_Storage> storage,
 	const std::string &name
 ) {
-	auto loadresult = load_binary_file(storage, name);
-	if (loadresult.first) {
-		auto &buffer = loadresult.second;
-		return { true, std::string(buffer.begin(), buffer.end()) };
-	} else {
+	// Read straight into the string rather than through a byte buffer.
+	uint64_t file_len = 0;
+	if (!SDL_GetStorageFileSize(storage.get(), name.c_str(), &file_len) || file_len == 0) {
+		return { false, {} };
+	}
+	std::string text(file_len, '\0');
+	if (!SDL_ReadStorageFile(storage.get(), name.c_str(), text.data(), file_len)) {
+		std::cerr << "Failed to read user file: " << name << std::endl;
 		return { false, {} };
 	}
+	return { true, std::move(text) };
 }
 
 bool write_binary_file(
@@ -85,8 +111,12 @@ bool write_text_file(
 	const std::string &name,
 	const std::string &buffer
 ) {
-	std::vector<uint8_t> bytebuffer(buffer.begin(), buffer.end());
-	return write_binary_file(storage, name, bytebuffer);
+	return SDL_WriteStorageFile(
+		storage.get(),
+		name.c_str(),
+		buffer.data(),
+		buffer.size()
+	);
 }
 
 
@@ -0,0 +1,50 @@
+#include "sdl_virtual_joystick.hpp"
+
+#include <iostream>
+
+namespace robikzinputtest::sdl {
+
+VirtualJoystick::VirtualJoystick(const SDL_VirtualJoystickDesc &desc) {
+	m_id = SDL_AttachVirtualJoystick(&desc);
+	if (m_id == 0) {
+		std::cerr << "SDL_AttachVirtualJoystick Error: " << SDL_GetError() << std::endl;
+		return;
+	}
+	m_joystick = SDL_OpenJoystick(m_id);
+	if (m_joystick == nullptr) {
+		std::cerr << "SDL_OpenJoystick Error: " << SDL_GetError() << std::endl;
+	}
+}
+
+VirtualJoystick::~VirtualJoystick() {
+	if (m_joystick != nullptr) {
+		SDL_CloseJoystick(m_joystick);
+	}
+	if (m_id != 0) {
+		SDL_DetachVirtualJoystick(m_id);
+	}
+}
+
+bool VirtualJoystick::set_axis(int axis, Sint16 value) {
+	return m_joystick != nullptr && SDL_SetJoystickVirtualAxis(m_joystick, axis, value);
+}
+
+bool VirtualJoystick::set_button(int button, bool down) {
+	return m_joystick != nullptr && SDL_SetJoystickVirtualButton(m_joystick, button, down);
+}
+
+bool VirtualJoystick::set_hat(int hat, Uint8 value) {
+	return m_joystick != nullptr && SDL_SetJoystickVirtualHat(m_joystick, hat, value);
+}
+
+bool VirtualJoystick::send_sensor(
+	SDL_SensorType type,
+	Uint64 sensor_timestamp_ns,
+	const float *data,
+	int num_values
+) {
+	return m_joystick != nullptr
+		&& SDL_SendJoystickVirtualSensorData(m_joystick, type, sensor_timestamp_ns, data, num_values);
+}
+
+} // namespace robikzinputtest::sdl
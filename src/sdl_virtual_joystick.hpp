@@ -0,0 +1,38 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+
+namespace robikzinputtest::sdl {
+
+/**
+ * An SDL virtual joystick that is attached and opened for the lifetime
+ * of the object.
+ *
+ * Virtual joysticks go through the same SDL event path as physical
+ * devices, so they can stand in for a real controller when the input
+ * needs to be reproduced.
+ */
+class VirtualJoystick {
+public:
+	VirtualJoystick(const SDL_VirtualJoystickDesc &desc);
+	~VirtualJoystick();
+
+	VirtualJoystick(const VirtualJoystick &) = delete;
+	VirtualJoystick &operator=(const VirtualJoystick &) = delete;
+
+	bool valid() const { return m_joystick != nullptr; }
+	SDL_JoystickID id() const { return m_id; }
+	SDL_Joystick *joystick() const { return m_joystick; }
+
+	bool set_axis(int axis, Sint16 value);
+	bool set_button(int button, bool down);
+	bool set_hat(int hat, Uint8 value);
+	/// Send a sample of a sensor declared in the description.
+	bool send_sensor(SDL_SensorType type, Uint64 sensor_timestamp_ns, const float *data, int num_values);
+
+private:
+	SDL_JoystickID m_id = 0;
+	SDL_Joystick *m_joystick = nullptr;
+};
+
+} // namespace robikzinputtest::sdl
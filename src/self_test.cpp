@@ -0,0 +1,206 @@
+#include "self_test.hpp"
+
+#include "sdl_virtual_joystick.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <vector>
+
+namespace robikzinputtest {
+
+/// Marker in the top-left corner, drawn over everything else.
+static const SDL_Rect MARKER_RECT = { 0, 0, 8, 8 };
+static const SDL_Color MARKER_COLOR = { 255, 0, 255, 255 };
+static const int MARKER_COLOR_TOLERANCE = 8;
+
+static const int TEST_BUTTON = 0;
+/// Give up on a press after this many frames without the marker.
+static const int TIMEOUT_FRAMES = 300;
+/// Idle frames between the presses vary, so that the presses land
+/// at various phases of the display refresh.
+static const int IDLE_FRAMES_MIN = 3;
+static const int IDLE_FRAMES_SPREAD = 5;
+
+struct SelfTestSample {
+	Uint64 latency_ns;
+	int frames;
+};
+
+enum class SelfTestPhase {
+	IDLE,
+	PRESSED,
+	RELEASED,
+};
+
+struct SelfTest::D {
+	int trials;
+	std::unique_ptr<sdl::VirtualJoystick> joystick;
+
+	SelfTestPhase phase = SelfTestPhase::IDLE;
+	/// Trial 0 spawns the gizmo and isn't measured.
+	int trial = 0;
+	int idle_frames_left = IDLE_FRAMES_MIN;
+	Uint64 press_ns = 0;
+	int frames_since_press = 0;
+	bool marker_visible = false;
+
+	std::vector<SelfTestSample> samples;
+	int timeouts = 0;
+
+	D(int trials) : trials(trials) {}
+
+	void press() {
+		joystick->set_button(TEST_BUTTON, true);
+		press_ns = SDL_GetTicksNS();
+		frames_since_press = 0;
+		phase = SelfTestPhase::PRESSED;
+	}
+
+	void release() {
+		joystick->set_button(TEST_BUTTON, false);
+		phase = SelfTestPhase::RELEASED;
+	}
+};
+
+static bool is_marker_pixel(Uint8 r, Uint8 g, Uint8 b) {
+	return std::abs(r - MARKER_COLOR.r) <= MARKER_COLOR_TOLERANCE
+		&& std::abs(g - MARKER_COLOR.g) <= MARKER_COLOR_TOLERANCE
+		&& std::abs(b - MARKER_COLOR.b) <= MARKER_COLOR_TOLERANCE;
+}
+
+/**
+ * Read the marker area back from the render target.
+ *
+ * The readback waits for the GPU to finish the frame; the area is kept
+ * tiny so that the copy itself costs next to nothing.
+ */
+static bool read_marker(SDL_Renderer &renderer) {
+	SDL_Surface *surface = SDL_RenderReadPixels(&renderer, &MARKER_RECT);
+	if (surface == nullptr) {
+		return false;
+	}
+	Uint8 r = 0, g = 0, b = 0, a = 0;
+	const bool read = SDL_ReadSurfacePixel(
+		surface, MARKER_RECT.w / 2, MARKER_RECT.h / 2, &r, &g, &b, &a
+	);
+	SDL_DestroySurface(surface);
+	return read && is_marker_pixel(r, g, b);
+}
+
+SelfTest::SelfTest(int trials)
+	: d(std::make_unique<D>(trials)) {
+	SDL_VirtualJoystickDesc desc;
+	SDL_INIT_INTERFACE(&desc);
+	desc.type = SDL_JOYSTICK_TYPE_UNKNOWN;
+	desc.nbuttons = TEST_BUTTON + 1;
+	desc.name = "Self-Test Joystick";
+	d->joystick = std::make_unique<sdl::VirtualJoystick>(desc);
+}
+
+SelfTest::~SelfTest() = default;
+
+bool SelfTest::valid() const {
+	return d->joystick->valid();
+}
+
+bool SelfTest::is_finished() const {
+	return d->trial > d->trials;
+}
+
+SDL_JoystickID SelfTest::joystick_id() const {
+	return d->joystick->id();
+}
+
+void SelfTest::begin_frame() {
+	if (d->phase != SelfTestPhase::IDLE || is_finished()) {
+		return;
+	}
+	if (d->idle_frames_left > 0) {
+		--d->idle_frames_left;
+	} else {
+		d->press();
+	}
+}
+
+void SelfTest::check_frame(SDL_Renderer &renderer, bool gizmo_active) {
+	if (gizmo_active) {
+		const SDL_FRect marker = {
+			static_cast<float>(MARKER_RECT.x),
+			static_cast<float>(MARKER_RECT.y),
+			static_cast<float>(MARKER_RECT.w),
+			static_cast<float>(MARKER_RECT.h),
+		};
+		SDL_SetRenderDrawBlendMode(&renderer, SDL_BLENDMODE_NONE);
+		SDL_SetRenderDrawColor(&renderer, MARKER_COLOR.r, MARKER_COLOR.g, MARKER_COLOR.b, MARKER_COLOR.a);
+		SDL_RenderFillRect(&renderer, &marker);
+	}
+	// Only the frames in-between the press and the marker's
+	// disappearance are of interest.
+	d->marker_visible = d->phase != SelfTestPhase::IDLE && read_marker(renderer);
+}
+
+void SelfTest::frame_presented(Uint64 present_ns) {
+	switch (d->phase) {
+	case SelfTestPhase::IDLE:
+		break;
+	case SelfTestPhase::PRESSED:
+		++d->frames_since_press;
+		if (d->marker_visible) {
+			if (d->trial > 0) {
+				d->samples.push_back({ present_ns - d->press_ns, d->frames_since_press });
+			}
+			d->release();
+		} else if (d->frames_since_press >= TIMEOUT_FRAMES) {
+			if (d->trial > 0) {
+				++d->timeouts;
+			}
+			d->release();
+		}
+		break;
+	case SelfTestPhase::RELEASED:
+		if (!d->marker_visible) {
+			++d->trial;
+			d->idle_frames_left = IDLE_FRAMES_MIN + d->trial % IDLE_FRAMES_SPREAD;
+			d->phase = SelfTestPhase::IDLE;
+		}
+		break;
+	}
+}
+
+bool SelfTest::write_summary(std::ostream &out) const {
+	out << "Self-test: " << d->samples.size() << " presses measured, "
+		<< d->timeouts << " timed out" << std::endl;
+	if (d->samples.empty()) {
+		return false;
+	}
+	std::vector<SelfTestSample> sorted = d->samples;
+	std::sort(sorted.begin(), sorted.end(), [](const auto &a, const auto &b) {
+		return a.latency_ns < b.latency_ns;
+	});
+	auto percentile = [&sorted](double fraction) -> const SelfTestSample & {
+		const size_t index = static_cast<size_t>(fraction * (sorted.size() - 1) + 0.5);
+		return sorted[std::min(index, sorted.size() - 1)];
+	};
+	auto ms = [](const SelfTestSample &sample) {
+		return static_cast<double>(sample.latency_ns) / 1e6;
+	};
+	out << std::fixed << std::setprecision(3)
+		<< "Input to pixel ms: min " << ms(sorted.front())
+		<< " p50 " << ms(percentile(0.50))
+		<< " p90 " << ms(percentile(0.90))
+		<< " max " << ms(sorted.back())
+		<< std::endl;
+	std::vector<int> frames;
+	for (const SelfTestSample &sample : d->samples) {
+		frames.push_back(sample.frames);
+	}
+	std::sort(frames.begin(), frames.end());
+	out << "Input to pixel frames: min " << frames.front()
+		<< " p50 " << frames[frames.size() / 2]
+		<< " max " << frames.back()
+		<< std::endl;
+	return true;
+}
+
+} // namespace robikzinputtest
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+
+#include <memory>
+#include <ostream>
+
+namespace robikzinputtest {
+
+/**
+ * Measures the latency from an input injection to the pixels of
+ * the frame that shows it.
+ *
+ * A button of a virtual joystick is pressed, which goes through the SDL
+ * event path and the controllers like any real input, and spawns and
+ * activates the joystick's gizmo. While the gizmo is active, a marker
+ * is drawn on top of the frame. The rendered frame is read back before
+ * it is presented, and the first frame that contains the marker ends
+ * the measurement. The press is then released and, after a few idle
+ * frames, repeated.
+ *
+ * The first press only spawns the gizmo and isn't measured.
+ */
+class SelfTest {
+public:
+	static constexpr int DEFAULT_TRIALS = 50;
+
+	SelfTest(int trials = DEFAULT_TRIALS);
+	~SelfTest();
+
+	bool valid() const;
+	bool is_finished() const;
+	/// The virtual joystick that injects the input.
+	SDL_JoystickID joystick_id() const;
+
+	/// Press or release the button; call before the events are handled.
+	void begin_frame();
+	/**
+	 * Draw the marker if the gizmo is active, and read the marker back
+	 * from the render target; call when the frame is drawn, before present.
+	 */
+	void check_frame(SDL_Renderer &renderer, bool gizmo_active);
+	/// Call right after the frame was presented.
+	void frame_presented(Uint64 present_ns);
+
+	/**
+	 * Write the measured latencies.
+	 *
+	 * Return false if no press was measured.
+	 */
+	bool write_summary(std::ostream &out) const;
+
+private:
+	struct D;
+	std::unique_ptr<D> d;
+};
+
+} // namespace robikzinputtest
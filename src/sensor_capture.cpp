@@ -0,0 +1,56 @@
+#include "sensor_capture.hpp"
+
+namespace robikzinputtest {
+
+/*
+  SensorStream
+*/
+
+void SensorStream::add(const SDL_GamepadSensorEvent &event) {
+	SensorSample sample;
+	sample.timestamp_ns = event.timestamp;
+	sample.sensor_timestamp_ns = event.sensor_timestamp;
+	sample.data = { event.data[0], event.data[1], event.data[2] };
+	samples.push(sample);
+
+	// A sample carries all of the sensor's axes at once.
+	if (event.sensor_timestamp != 0) {
+		native_rate.add(event.sensor_timestamp, PollingRateAnalyzer::axis_control(0));
+	}
+	delivery_rate.add(event.timestamp, PollingRateAnalyzer::axis_control(0));
+	latency.add_input(event.timestamp);
+}
+
+void SensorStream::clear() {
+	samples.clear();
+	native_rate.clear();
+	delivery_rate.clear();
+	latency.clear();
+}
+
+/*
+  SensorCapture
+*/
+
+void SensorCapture::handle_event(const SDL_Event &event) {
+	if (event.type != SDL_EVENT_GAMEPAD_SENSOR_UPDATE) {
+		return;
+	}
+	if (is_gyro_sensor(event.gsensor.sensor)) {
+		gyro.add(event.gsensor);
+	} else if (is_accel_sensor(event.gsensor.sensor)) {
+		accel.add(event.gsensor);
+	}
+}
+
+void SensorCapture::clear() {
+	gyro.clear();
+	accel.clear();
+}
+
+void SensorCapture::presented(Uint64 present_ns) {
+	gyro.latency.presented(present_ns);
+	accel.latency.presented(present_ns);
+}
+
+} // namespace robikzinputtest
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "latency_tracker.hpp"
+#include "polling_rate_analyzer.hpp"
+#include "ring_buffer.hpp"
+
+#include <SDL3/SDL.h>
+
+#include <array>
+
+namespace robikzinputtest {
+
+struct SensorSample {
+	/// When SDL got the sample, in SDL_GetTicksNS() nanoseconds.
+	Uint64 timestamp_ns = 0;
+	/// When the device took the sample, by the device's own clock; 0 if unknown.
+	Uint64 sensor_timestamp_ns = 0;
+	std::array<float, 3> data {};
+};
+
+/**
+ * Samples of a single sensor of a device, and their timing.
+ */
+struct SensorStream {
+	/// Samples kept; about a second at the usual gamepad sensor rates.
+	static constexpr size_t HISTORY = 1024;
+
+	RingBuffer<SensorSample, HISTORY> samples;
+	/// Rate by the sensor timestamps: the rate the device samples at.
+	PollingRateAnalyzer native_rate;
+	/// Rate by the event timestamps: the rate the samples reach the app at.
+	PollingRateAnalyzer delivery_rate;
+	LatencyTracker latency;
+
+	void add(const SDL_GamepadSensorEvent &event);
+	void clear();
+};
+
+/**
+ * Capture of the gyroscope and accelerometer samples of a gamepad.
+ *
+ * The samples come at the sensor's native rate, often faster than
+ * the frame rate; every one of them is kept in the ring buffers.
+ */
+struct SensorCapture {
+	SensorStream gyro;
+	SensorStream accel;
+
+	/// Capture the sensor event; other events are ignored.
+	void handle_event(const SDL_Event &event);
+	void clear();
+	void presented(Uint64 present_ns);
+};
+
+/// Gyroscopes report radians per second, accelerometers meters per second squared.
+inline bool is_gyro_sensor(int sensor) {
+	return sensor == SDL_SENSOR_GYRO
+		|| sensor == SDL_SENSOR_GYRO_L
+		|| sensor == SDL_SENSOR_GYRO_R;
+}
+
+inline bool is_accel_sensor(int sensor) {
+	return sensor == SDL_SENSOR_ACCEL
+		|| sensor == SDL_SENSOR_ACCEL_L
+		|| sensor == SDL_SENSOR_ACCEL_R;
+}
+
+} // namespace robikzinputtest
@@ -0,0 +1,92 @@
+#include "sensor_simulator.hpp"
+
+#include "sdl_virtual_joystick.hpp"
+
+#include <array>
+#include <cmath>
+
+namespace robikzinputtest {
+
+/// Angular speed of the simulated rotation, in radians per second.
+static const float GYRO_AMPLITUDE = 1.0f;
+/// Circles the simulated rotation makes per second.
+static const float GYRO_FREQUENCY_HZ = 0.25f;
+/// A stall longer than this drops the samples instead of catching up.
+static const Uint64 MAX_BACKLOG_NS = 100'000'000;
+
+struct SensorSimulator::D {
+	std::unique_ptr<sdl::VirtualJoystick> joystick;
+	Uint64 period_ns;
+	Uint64 start_ns = 0;
+	Uint64 next_sample_ns = 0;
+	int frame = 0;
+
+	D(float rate_hz) : period_ns(static_cast<Uint64>(1e9 / rate_hz)) {}
+
+	void send_sample(Uint64 sensor_timestamp_ns) {
+		const float t = static_cast<float>(sensor_timestamp_ns - start_ns) / 1e9f;
+		const float phase = 2.0f * SDL_PI_F * GYRO_FREQUENCY_HZ * t;
+		const std::array<float, 3> gyro = {
+			GYRO_AMPLITUDE * std::sin(phase),
+			GYRO_AMPLITUDE * std::cos(phase),
+			0.0f,
+		};
+		const std::array<float, 3> accel = { 0.0f, SDL_STANDARD_GRAVITY, 0.0f };
+		joystick->send_sensor(SDL_SENSOR_GYRO, sensor_timestamp_ns, gyro.data(), static_cast<int>(gyro.size()));
+		joystick->send_sensor(SDL_SENSOR_ACCEL, sensor_timestamp_ns, accel.data(), static_cast<int>(accel.size()));
+	}
+};
+
+SensorSimulator::SensorSimulator(float rate_hz)
+	: d(std::make_unique<D>(rate_hz)) {
+	const std::array<SDL_VirtualJoystickSensorDesc, 2> sensors = {{
+		{ SDL_SENSOR_GYRO, rate_hz },
+		{ SDL_SENSOR_ACCEL, rate_hz },
+	}};
+	SDL_VirtualJoystickDesc desc;
+	SDL_INIT_INTERFACE(&desc);
+	// A gamepad gets a mapping from SDL, so it's handled by the gamepad
+	// controller, which enables the sensors.
+	desc.type = SDL_JOYSTICK_TYPE_GAMEPAD;
+	desc.naxes = SDL_GAMEPAD_AXIS_COUNT;
+	desc.nbuttons = SDL_GAMEPAD_BUTTON_COUNT;
+	desc.nsensors = static_cast<Uint16>(sensors.size());
+	desc.sensors = sensors.data();
+	desc.name = "Sensor Simulator Gamepad";
+	d->joystick = std::make_unique<sdl::VirtualJoystick>(desc);
+}
+
+SensorSimulator::~SensorSimulator() = default;
+
+bool SensorSimulator::valid() const {
+	return d->joystick->valid();
+}
+
+SDL_JoystickID SensorSimulator::joystick_id() const {
+	return d->joystick->id();
+}
+
+void SensorSimulator::begin_frame() {
+	if (!valid()) {
+		return;
+	}
+	// Press on the first frame and release on the next one.
+	if (d->frame < 2) {
+		d->joystick->set_button(SDL_GAMEPAD_BUTTON_SOUTH, d->frame == 0);
+		++d->frame;
+	}
+
+	const Uint64 now_ns = SDL_GetTicksNS();
+	if (d->start_ns == 0) {
+		d->start_ns = now_ns;
+		d->next_sample_ns = now_ns;
+	}
+	if (now_ns > d->next_sample_ns && now_ns - d->next_sample_ns > MAX_BACKLOG_NS) {
+		d->next_sample_ns = now_ns;
+	}
+	for (; d->next_sample_ns <= now_ns; d->next_sample_ns += d->period_ns) {
+		d->send_sample(d->next_sample_ns);
+	}
+}
+
+} // namespace robikzinputtest
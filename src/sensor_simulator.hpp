@@ -0,0 +1,37 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+
+#include <memory>
+
+namespace robikzinputtest {
+
+/**
+ * A virtual gamepad with a gyroscope and an accelerometer that streams
+ * synthetic samples at a fixed rate.
+ *
+ * The samples go through the same SDL path as those of a physical pad,
+ * so the sensor capture and the gyro steering can be checked without
+ * the hardware. The gyro turns the pad in slow circles; the
+ * accelerometer reports the gravity. The first frame presses and
+ * releases the south button, so that the pad gets its gizmo.
+ */
+class SensorSimulator {
+public:
+	static constexpr float DEFAULT_RATE_HZ = 500.0f;
+
+	SensorSimulator(float rate_hz = DEFAULT_RATE_HZ);
+	~SensorSimulator();
+
+	bool valid() const;
+	SDL_JoystickID joystick_id() const;
+
+	/// Send the samples due up to now; call before the events are handled.
+	void begin_frame();
+
+private:
+	struct D;
+	std::unique_ptr<D> d;
+};
+
+} // namespace robikzinputtest
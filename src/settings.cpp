@@ -2,153 +2,314 @@
 
 #include "properties_file.hpp"
 #include "text.hpp"
+#include "video_settings.hpp"
 
-#include <memory>
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
 
 namespace robikzinputtest {
 
 /*
-  Property import/export
+  Settings fields table
 */
 
-class PropImportExport {
-public:
-	virtual ~PropImportExport() = default;
-	virtual std::string name() const = 0;
-	virtual bool is_property(const std::string &name) const = 0;
-	virtual void import_value(const Variant &value) = 0;
-	virtual Variant export_value() const = 0;
+enum class SettingType : uint8_t {
+	BOOL,
+	INT,
+	UINT32,
+	FLOAT,
+	COLOR,
+	DISPLAY_ID_MEMO,
+	STRING,
 };
 
-template<typename T>
-class PropRef : public PropImportExport {
-public:
-	PropRef(const std::string &name, T &ref)
-		: m_name(name), m_ref(ref) {
-	}
+/**
+ * A field of Settings that is saved as a property: its name, its
+ * type and the member pointer to it.
+ */
+struct SettingField {
+	union Member {
+		bool Settings::*b;
+		int Settings::*i;
+		uint32_t Settings::*u32;
+		float Settings::*f;
+		Color Settings::*color;
+		DisplayIdMemo Settings::*display_id_memo;
+		std::string Settings::*s;
 
-	std::string name() const override {
-		return m_name;
-	}
+		constexpr Member(bool Settings::*m) : b(m) {}
+		constexpr Member(int Settings::*m) : i(m) {}
+		constexpr Member(uint32_t Settings::*m) : u32(m) {}
+		constexpr Member(float Settings::*m) : f(m) {}
+		constexpr Member(Color Settings::*m) : color(m) {}
+		constexpr Member(DisplayIdMemo Settings::*m) : display_id_memo(m) {}
+		constexpr Member(std::string Settings::*m) : s(m) {}
+	};
 
-	bool is_property(const std::string &name) const override {
-		return text::tolower(m_name) == text::tolower(name);
-	}
+	std::string_view name;
+	SettingType type;
+	Member member;
 
-	void import_value(const Variant &value) override {
-		m_ref = static_cast<T>(value);
+	constexpr SettingField(std::string_view name, bool Settings::*m)
+		: name(name), type(SettingType::BOOL), member(m) {}
+	constexpr SettingField(std::string_view name, int Settings::*m)
+		: name(name), type(SettingType::INT), member(m) {}
+	constexpr SettingField(std::string_view name, uint32_t Settings::*m)
+		: name(name), type(SettingType::UINT32), member(m) {}
+	constexpr SettingField(std::string_view name, float Settings::*m)
+		: name(name), type(SettingType::FLOAT), member(m) {}
+	constexpr SettingField(std::string_view name, Color Settings::*m)
+		: name(name), type(SettingType::COLOR), member(m) {}
+	constexpr SettingField(std::string_view name, DisplayIdMemo Settings::*m)
+		: name(name), type(SettingType::DISPLAY_ID_MEMO), member(m) {}
+	constexpr SettingField(std::string_view name, std::string Settings::*m)
+		: name(name), type(SettingType::STRING), member(m) {}
+
+	/// Convert the value's text form straight into the member.
+	void import_text(Settings &settings, std::string_view text) const {
+		switch (type) {
+		case SettingType::BOOL:
+			settings.*member.b = Variant::parse_bool(text);
+			break;
+		case SettingType::INT:
+			settings.*member.i = static_cast<int32_t>(Variant::parse_int64(text));
+			break;
+		case SettingType::UINT32:
+			settings.*member.u32 = static_cast<uint32_t>(Variant::parse_int64(text));
+			break;
+		case SettingType::FLOAT:
+			settings.*member.f = Variant::parse_float(text);
+			break;
+		case SettingType::COLOR:
+			settings.*member.color = Color::from_hex(text);
+			break;
+		case SettingType::DISPLAY_ID_MEMO:
+			settings.*member.display_id_memo = decode_display_id_memo(text);
+			break;
+		case SettingType::STRING:
+			(settings.*member.s).assign(text);
+			break;
+		}
 	}
 
-	Variant export_value() const override {
-		return Variant(m_ref);
+	bool equals(const Settings &a, const Settings &b) const {
+		switch (type) {
+		case SettingType::BOOL:
+			return a.*member.b == b.*member.b;
+		case SettingType::INT:
+			return a.*member.i == b.*member.i;
+		case SettingType::UINT32:
+			return a.*member.u32 == b.*member.u32;
+		case SettingType::FLOAT:
+			return a.*member.f == b.*member.f;
+		case SettingType::COLOR: {
+			const Color &ca = a.*member.color;
+			const Color &cb = b.*member.color;
+			return ca.r == cb.r && ca.g == cb.g && ca.b == cb.b && ca.a == cb.a;
+		}
+		case SettingType::DISPLAY_ID_MEMO: {
+			const DisplayIdMemo &ma = a.*member.display_id_memo;
+			const DisplayIdMemo &mb = b.*member.display_id_memo;
+			return ma.id == mb.id && ma.name == mb.name;
+		}
+		case SettingType::STRING:
+			return a.*member.s == b.*member.s;
+		}
+		return true;
 	}
 
-private:
-	std::string m_name;
-	T &m_ref;
+	Variant export_value(const Settings &settings) const {
+		switch (type) {
+		case SettingType::BOOL:
+			return Variant(settings.*member.b);
+		case SettingType::INT:
+			return Variant(static_cast<int32_t>(settings.*member.i));
+		case SettingType::UINT32:
+			return Variant(settings.*member.u32);
+		case SettingType::FLOAT:
+			return Variant(settings.*member.f);
+		case SettingType::COLOR:
+			return Variant(settings.*member.color);
+		case SettingType::DISPLAY_ID_MEMO:
+			return Variant(settings.*member.display_id_memo);
+		case SettingType::STRING:
+			return Variant(settings.*member.s);
+		}
+		return Variant();
+	}
 };
 
-static std::unique_ptr<PropRef<bool>> boolprop(const std::string &name, bool &ref) {
-	return std::make_unique<PropRef<bool>>(name, ref);
-}
+/**
+ * All saved settings. A new setting needs only its member in Settings
+ * and its line here.
+ */
+static constexpr SettingField SETTING_FIELDS[] = {
+	{ "show_fps", &Settings::show_fps },
+	{ "show_ui_frame_counter", &Settings::show_ui_frame_counter },
+	{ "show_help", &Settings::show_help },
+	{ "show_help_at_start", &Settings::show_help_at_start },
+	{ "show_settings_at_start", &Settings::show_settings_at_start },
+	{ "show_program_log", &Settings::show_program_log },
+	{ "show_performance_dashboard", &Settings::show_performance_dashboard },
+	{ "show_joystick_info", &Settings::show_joystick_info },
+	{ "show_mouse_info", &Settings::show_mouse_info },
+	{ "show_keyboard_info", &Settings::show_keyboard_info },
 
-static std::unique_ptr<PropRef<int>> intprop(const std::string &name, int &ref) {
-	return std::make_unique<PropRef<int>>(name, ref);
-}
+	{ "program_log_opacity", &Settings::program_log_opacity },
 
-static std::unique_ptr<PropRef<uint32_t>> uint32prop(const std::string &name, uint32_t &ref) {
-	return std::make_unique<PropRef<uint32_t>>(name, ref);
-}
+	{ "limit_fps", &Settings::limit_fps },
+	{ "target_fps", &Settings::target_fps },
+	{ "lock_to_refresh_rate", &Settings::lock_to_refresh_rate },
+	{ "refresh_divisor", &Settings::refresh_divisor },
 
-static std::unique_ptr<PropRef<float>> floatprop(const std::string &name, float &ref) {
-	return std::make_unique<PropRef<float>>(name, ref);
-}
+	// Arena settings
+	{ "gizmo_width", &Settings::gizmo_width },
+	{ "gizmo_height", &Settings::gizmo_height },
+	{ "gizmo_speed", &Settings::gizmo_speed },
+	{ "joystick_deadzone", &Settings::joystick_deadzone },
+	{ "joystick_outer_deadzone", &Settings::joystick_outer_deadzone },
+	{ "joystick_anti_deadzone", &Settings::joystick_anti_deadzone },
+	{ "joystick_response_exponent", &Settings::joystick_response_exponent },
+	{ "joystick_radial_deadzone", &Settings::joystick_radial_deadzone },
+	{ "gyro_steering", &Settings::gyro_steering },
+	{ "gyro_sensitivity", &Settings::gyro_sensitivity },
+	{ "background_color", &Settings::background_color },
+	{ "background_animate", &Settings::background_animate },
+	{ "background_flash_color", &Settings::background_flash_color },
+	{ "background_flash_on_gizmo_action", &Settings::background_flash_on_gizmo_action },
 
-static std::unique_ptr<PropRef<Color>> colorprop(const std::string &name, Color &ref) {
-	return std::make_unique<PropRef<Color>>(name, ref);
-}
+	// Video settings
+	{ "display_mode", &Settings::display_mode },
+	{ "windowed_x", &Settings::windowed_x },
+	{ "windowed_y", &Settings::windowed_y },
+	{ "windowed_width", &Settings::windowed_width },
+	{ "windowed_height", &Settings::windowed_height },
+	{ "windowed_maximized", &Settings::windowed_maximized },
+	{ "fullscreen_width", &Settings::fullscreen_width },
+	{ "fullscreen_height", &Settings::fullscreen_height },
+	{ "fullscreen_refresh_rate_numerator", &Settings::fullscreen_refresh_rate_numerator },
+	{ "fullscreen_refresh_rate_denominator", &Settings::fullscreen_refresh_rate_denominator },
+	{ "fullscreen_pixel_format", &Settings::fullscreen_pixel_format },
+	{ "fullscreen_pixel_density", &Settings::fullscreen_pixel_density },
+	{ "fullscreen_display", &Settings::fullscreen_display },
+	{ "vsync", &Settings::vsync },
+	{ "render_driver", &Settings::render_driver },
 
-static std::unique_ptr<PropRef<std::string>> strprop(const std::string &name, std::string &ref) {
-	return std::make_unique<PropRef<std::string>>(name, ref);
-}
+	// Log settings
+	{ "log_joystick_axis_events", &Settings::log_joystick_axis_events },
+	{ "log_joystick_button_events", &Settings::log_joystick_button_events },
+	{ "log_joystick_hat_events", &Settings::log_joystick_hat_events },
+};
 
-static std::unique_ptr<PropRef<DisplayIdMemo>> displayidmemoprop(const std::string &name, DisplayIdMemo &ref) {
-	return std::make_unique<PropRef<DisplayIdMemo>>(name, ref);
-}
+static constexpr size_t SETTING_FIELDS_COUNT = sizeof(SETTING_FIELDS) / sizeof(SETTING_FIELDS[0]);
 
-std::vector<std::unique_ptr<PropImportExport>> create_settings_prop_map(Settings &settings) {
-	std::vector<std::unique_ptr<PropImportExport>> props;
-	props.push_back(boolprop("show_fps", settings.show_fps));
-	props.push_back(boolprop("show_ui_frame_counter", settings.show_ui_frame_counter));
-	props.push_back(boolprop("show_help", settings.show_help));
-	props.push_back(boolprop("show_help_at_start", settings.show_help_at_start));
-	props.push_back(boolprop("show_settings_at_start", settings.show_settings_at_start));
-	props.push_back(boolprop("show_program_log", settings.show_program_log));
-	props.push_back(boolprop("show_joystick_info", settings.show_joystick_info));
+/*
+  Compile-time perfect hash of the setting names
+*/
 
-	props.push_back(floatprop("program_log_opacity", settings.program_log_opacity));
+/**
+ * Slots of the hash table; a power of two. The chance that a seed
+ * places all the n names without a collision is about
+ * exp(-n * (n - 1) / (2 * SLOTS)): about 0.6 for 47 settings and still
+ * 0.09 for 100, so the search ends within a few seeds.
+ */
+static constexpr size_t SETTING_HASH_SLOTS = 2048;
+static constexpr uint8_t SETTING_HASH_EMPTY = 0xff;
+/**
+ * Bound of the seed search. A seed costs about the hashing of all the
+ * names at compile time; with 47 settings the first seed fits, and
+ * the search and the table take under 100k constexpr steps, far from
+ * the compilers' default limits (Clang's is 2^20). Reaching the bound
+ * means the table needs more slots.
+ */
+static constexpr uint32_t SETTING_HASH_MAX_SEED = 64;
 
-	props.push_back(boolprop("limit_fps", settings.limit_fps));
-	props.push_back(floatprop("target_fps", settings.target_fps));
+static_assert(SETTING_FIELDS_COUNT < SETTING_HASH_EMPTY, "Too many settings for the hash table");
 
-	// Arena settings
-	props.push_back(intprop("gizmo_width", settings.gizmo_width));
-	props.push_back(intprop("gizmo_height", settings.gizmo_height));
-	props.push_back(floatprop("gizmo_speed", settings.gizmo_speed));
-	props.push_back(intprop("joystick_deadzone", settings.joystick_deadzone));
-	props.push_back(colorprop("background_color", settings.background_color));
-	props.push_back(boolprop("background_animate", settings.background_animate));
-	props.push_back(colorprop("background_flash_color", settings.background_flash_color));
-	props.push_back(boolprop("background_flash_on_gizmo_action", settings.background_flash_on_gizmo_action));
+/// Case-insensitive FNV-1a, as the property names are matched regardless of case.
+static constexpr size_t setting_name_slot(std::string_view name, uint32_t seed) {
+	uint32_t hash = 2166136261u ^ seed;
+	for (char c : name) {
+		hash ^= static_cast<uint8_t>(text::ascii_tolower(c));
+		hash *= 16777619u;
+	}
+	return hash & (SETTING_HASH_SLOTS - 1);
+}
 
-	// Video settings
-	props.push_back(intprop("display_mode", settings.display_mode));
-	props.push_back(intprop("windowed_x", settings.windowed_x));
-	props.push_back(intprop("windowed_y", settings.windowed_y));
-	props.push_back(intprop("windowed_width", settings.windowed_width));
-	props.push_back(intprop("windowed_height", settings.windowed_height));
-	props.push_back(boolprop("windowed_maximized", settings.windowed_maximized));
-	props.push_back(intprop("fullscreen_width", settings.fullscreen_width));
-	props.push_back(intprop("fullscreen_height", settings.fullscreen_height));
-	props.push_back(intprop("fullscreen_refresh_rate_numerator", settings.fullscreen_refresh_rate_numerator));
-	props.push_back(intprop("fullscreen_refresh_rate_denominator", settings.fullscreen_refresh_rate_denominator));
-	props.push_back(uint32prop("fullscreen_pixel_format", settings.fullscreen_pixel_format));
-	props.push_back(floatprop("fullscreen_pixel_density", settings.fullscreen_pixel_density));
-	props.push_back(displayidmemoprop("fullscreen_display", settings.fullscreen_display));
-	props.push_back(intprop("vsync", settings.vsync));
+static constexpr uint32_t find_setting_hash_seed() {
+	for (uint32_t seed = 0; seed < SETTING_HASH_MAX_SEED; ++seed) {
+		// A bitmap, so that a seed costs little beyond the hashing.
+		std::array<uint64_t, SETTING_HASH_SLOTS / 64> used {};
+		bool collision = false;
+		for (size_t field = 0; field < SETTING_FIELDS_COUNT && !collision; ++field) {
+			const size_t slot = setting_name_slot(SETTING_FIELDS[field].name, seed);
+			const uint64_t bit = uint64_t(1) << (slot % 64);
+			collision = (used[slot / 64] & bit) != 0;
+			used[slot / 64] |= bit;
+		}
+		if (!collision) {
+			return seed;
+		}
+	}
+	return SETTING_HASH_MAX_SEED;
+}
 
-	// Log settings
-	props.push_back(boolprop("log_joystick_axis_events", settings.log_joystick_axis_events));
-	props.push_back(boolprop("log_joystick_button_events", settings.log_joystick_button_events));
-	props.push_back(boolprop("log_joystick_hat_events", settings.log_joystick_hat_events));
+static constexpr uint32_t SETTING_HASH_SEED = find_setting_hash_seed();
+static_assert(SETTING_HASH_SEED < SETTING_HASH_MAX_SEED, "No perfect hash of the setting names found");
 
-	return props;
+static constexpr std::array<uint8_t, SETTING_HASH_SLOTS> build_setting_hash_table() {
+	std::array<uint8_t, SETTING_HASH_SLOTS> table {};
+	for (uint8_t &slot : table) {
+		slot = SETTING_HASH_EMPTY;
+	}
+	for (size_t field = 0; field < SETTING_FIELDS_COUNT; ++field) {
+		table[setting_name_slot(SETTING_FIELDS[field].name, SETTING_HASH_SEED)] = static_cast<uint8_t>(field);
+	}
+	return table;
+}
+
+static constexpr std::array<uint8_t, SETTING_HASH_SLOTS> SETTING_HASH_TABLE = build_setting_hash_table();
+
+/// The field of the property name, or nullptr if there's none.
+static const SettingField *find_setting_field(std::string_view name) {
+	const uint8_t field = SETTING_HASH_TABLE[setting_name_slot(name, SETTING_HASH_SEED)];
+	if (field == SETTING_HASH_EMPTY || !text::equals_ignore_case(SETTING_FIELDS[field].name, name)) {
+		return nullptr;
+	}
+	return &SETTING_FIELDS[field];
 }
 
 /*
   Settings
 */
 
-void Settings::import_properties(const std::vector<Property> &properties) {
-	auto props_map = create_settings_prop_map(*this);
+void Settings::import_properties(const std::vector<PropertyView> &properties) {
 	for (const auto &prop : properties) {
-		for (const auto &pmap : props_map) {
-			if (pmap->is_property(prop.name)) {
-				pmap->import_value(prop.value);
-				break;
-			}
+		if (const SettingField *field = find_setting_field(prop.name)) {
+			field->import_text(*this, prop.value);
+		}
+	}
+}
+
+bool Settings::operator==(const Settings &other) const {
+	for (const SettingField &field : SETTING_FIELDS) {
+		if (!field.equals(*this, other)) {
+			return false;
 		}
 	}
+	return true;
 }
 
 std::vector<Property> Settings::export_properties() const {
-	auto props_map = create_settings_prop_map(const_cast<Settings&>(*this));
 	std::vector<Property> properties;
-	for (const auto &pmap : props_map) {
+	properties.reserve(SETTING_FIELDS_COUNT);
+	for (const SettingField &field : SETTING_FIELDS) {
 		Property prop;
-		prop.name = pmap->name();
-		prop.value = pmap->export_value();
-		properties.push_back(prop);
+		prop.name = std::string(field.name);
+		prop.value = field.export_value(*this);
+		properties.push_back(std::move(prop));
 	}
 	return properties;
 }
@@ -3,12 +3,14 @@
 #include "color.hpp"
 #include "video.hpp"
 
+#include <string>
 #include <utility>
 #include <vector>
 
 namespace robikzinputtest {
 
 struct Property;
+struct PropertyView;
 
 struct Settings {
 	bool show_fps = true;
@@ -17,12 +19,18 @@ struct Settings {
 	bool show_help_at_start = true;
 	bool show_settings_at_start = false;
 	bool show_program_log = false;
+	bool show_performance_dashboard = false;
 	bool show_joystick_info = false;
+	bool show_mouse_info = false;
+	bool show_keyboard_info = false;
 
 	float program_log_opacity = 1.0f;
 
 	bool limit_fps = true;
 	float target_fps = 60.0f;
+	/// Pace to the display refresh rate divided by refresh_divisor instead.
+	bool lock_to_refresh_rate = false;
+	int refresh_divisor = 1;
 
 	// Arena settings
 	int gizmo_width = 50;
@@ -36,6 +44,18 @@ struct Settings {
 	 * XBox Series Elite 2 plus some safety padding.
 	 */
 	int joystick_deadzone = static_cast<int>(32767.0f * 0.2f);
+	/// Distance from the axis maximum past which the axis gives full output.
+	int joystick_outer_deadzone = 0;
+	/// Lowest output of the axis past the deadzone (0.0 - 1.0).
+	float joystick_anti_deadzone = 0.0f;
+	/// Axis response curve power; 1.0 is linear.
+	float joystick_response_exponent = 1.0f;
+	/// Apply the deadzones on the stick's magnitude instead of each axis.
+	bool joystick_radial_deadzone = false;
+	/// Move the gamepad gizmos by rotating the gamepad.
+	bool gyro_steering = false;
+	/// Gizmo motion in pixels per radian of the gamepad rotation.
+	float gyro_sensitivity = 400.0f;
 
 	Color background_color = { 0.0f, 0.20f, 0.0f, 1.0f };
 	bool background_animate = true;
@@ -57,18 +77,27 @@ struct Settings {
 	float fullscreen_pixel_density = 0.0f;
 	DisplayIdMemo fullscreen_display;
 	int vsync = SDL_RENDERER_VSYNC_DISABLED;
+	/// Name of the SDL render driver; empty lets SDL pick.
+	std::string render_driver;
 
 	// Log settings
 	bool log_joystick_axis_events = false;
 	bool log_joystick_button_events = false;
 	bool log_joystick_hat_events = false;
 
-	void import_properties(const std::vector<Property> &properties);
+	void import_properties(const std::vector<PropertyView> &properties);
 	std::vector<Property> export_properties() const;
+
+	/// Compare the saved settings; cheap enough to be done every frame.
+	bool operator==(const Settings &other) const;
+	bool operator!=(const Settings &other) const {
+		return !(*this == other);
+	}
 };
 
 class SettingsIO {
 public:
+	virtual ~SettingsIO() = default;
 	virtual bool save(const Settings &settings) = 0;
 	virtual std::pair<bool, Settings> load() = 0;
 };
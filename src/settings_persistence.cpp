@@ -0,0 +1,130 @@
+#include "settings_persistence.hpp"
+
+#include <algorithm>
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace robikzinputtest {
+
+struct SettingsPersistence::D {
+	/// Settings waiting for the worker, and where they go.
+	struct Write {
+		std::shared_ptr<SettingsIO> io;
+		Settings settings;
+	};
+
+	// Main thread
+	std::shared_ptr<SettingsIO> io;
+	Settings last_seen;
+	/// Settings last handed to the worker.
+	Settings last_queued;
+	/// When the settings last changed; 0 if there's nothing to save.
+	Uint64 changed_at_ns = 0;
+	/// The destination has the settings; false until they're first written.
+	bool saved;
+
+	// Shared with the worker
+	std::mutex mutex;
+	std::condition_variable wakeup;
+	/// At most one per destination; a newer write replaces the older.
+	std::vector<Write> pending;
+	bool stopping = false;
+
+	std::thread worker;
+
+	D(std::unique_ptr<SettingsIO> io, const Settings &settings, bool saved)
+		: io(std::move(io)), last_seen(settings), last_queued(settings), saved(saved) {
+		worker = std::thread([this]() { run(); });
+	}
+
+	void queue(const Settings &settings, bool force = false) {
+		changed_at_ns = 0;
+		if (!force && saved && settings == last_queued) {
+			return;
+		}
+		saved = true;
+		last_queued = settings;
+		Write write { io, settings };
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			auto it = std::find_if(pending.begin(), pending.end(),
+				[this](const Write &pending_write) { return pending_write.io == io; });
+			if (it != pending.end()) {
+				*it = std::move(write);
+			} else {
+				pending.push_back(std::move(write));
+			}
+		}
+		wakeup.notify_one();
+	}
+
+	void run() {
+		std::unique_lock<std::mutex> lock(mutex);
+		for (;;) {
+			wakeup.wait(lock, [this]() { return !pending.empty() || stopping; });
+			if (pending.empty()) {
+				// Stopping with nothing left to write.
+				return;
+			}
+			std::vector<Write> writes = std::move(pending);
+			pending.clear();
+			lock.unlock();
+			for (const Write &write : writes) {
+				if (!write.io->save(write.settings)) {
+					std::cerr << "Failed to save settings" << std::endl;
+				}
+			}
+			lock.lock();
+		}
+	}
+};
+
+SettingsPersistence::SettingsPersistence(std::unique_ptr<SettingsIO> io, const Settings &settings, bool saved)
+	: d(std::make_unique<D>(std::move(io), settings, saved)) {
+}
+
+SettingsPersistence::~SettingsPersistence() {
+	if (d->changed_at_ns != 0 || !d->saved) {
+		d->queue(d->last_seen);
+	}
+	{
+		std::lock_guard<std::mutex> lock(d->mutex);
+		d->stopping = true;
+	}
+	d->wakeup.notify_one();
+	d->worker.join();
+}
+
+void SettingsPersistence::update(const Settings &settings, Uint64 now_ns) {
+	if (settings != d->last_seen) {
+		// Wait for the settings to settle, e.g. while a slider is dragged.
+		d->last_seen = settings;
+		d->changed_at_ns = now_ns;
+	} else if (d->changed_at_ns != 0 && now_ns - d->changed_at_ns >= DEBOUNCE_NS) {
+		d->queue(d->last_seen);
+	}
+}
+
+void SettingsPersistence::save(const Settings &settings) {
+	d->last_seen = settings;
+	d->queue(settings);
+}
+
+void SettingsPersistence::switch_to(std::unique_ptr<SettingsIO> io, const Settings &settings, bool saved) {
+	// The pending changes still go where they belong.
+	if (d->changed_at_ns != 0 || !d->saved) {
+		d->queue(d->last_seen);
+	}
+	d->io = std::move(io);
+	d->last_seen = settings;
+	d->last_queued = settings;
+	d->saved = saved;
+	if (!saved) {
+		d->queue(settings, true);
+	}
+}
+
+} // namespace robikzinputtest
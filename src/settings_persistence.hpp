@@ -0,0 +1,55 @@
+#pragma once
+
+#include "settings.hpp"
+
+#include <SDL3/SDL.h>
+
+#include <memory>
+
+namespace robikzinputtest {
+
+/**
+ * Saves the settings in the background shortly after they change.
+ *
+ * The settings are compared with the last seen ones every frame; once
+ * they stay unchanged for DEBOUNCE_NS, a copy is handed to a worker
+ * thread that serializes and writes it. A newer copy replaces one that
+ * is still waiting, so the worker only ever writes the latest settings.
+ * The main loop never waits on the storage.
+ *
+ * Settings that weren't loaded from a file, like the defaults on the
+ * first run, are written at the next save even if they didn't change,
+ * so that the file gets created.
+ */
+class SettingsPersistence {
+public:
+	static constexpr Uint64 DEBOUNCE_NS = 1'000'000'000;
+
+	/**
+	 * The settings are those that were just loaded; saved is false if
+	 * there was no file to load them from.
+	 */
+	SettingsPersistence(std::unique_ptr<SettingsIO> io, const Settings &settings, bool saved);
+	/// Write the pending changes and wait for the writes to finish.
+	~SettingsPersistence();
+
+	SettingsPersistence(const SettingsPersistence &) = delete;
+	SettingsPersistence &operator=(const SettingsPersistence &) = delete;
+
+	/// Look for changes of the settings; call every frame.
+	void update(const Settings &settings, Uint64 now_ns);
+	/// Queue the settings to be written right away, if they changed or aren't saved yet.
+	void save(const Settings &settings);
+	/**
+	 * Save to another destination from now on, e.g. another profile.
+	 * The pending changes are still written to the old one. If the
+	 * settings aren't saved yet, they're written right away.
+	 */
+	void switch_to(std::unique_ptr<SettingsIO> io, const Settings &settings, bool saved);
+
+private:
+	struct D;
+	std::unique_ptr<D> d;
+};
+
+} // namespace robikzinputtest
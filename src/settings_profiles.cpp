@@ -0,0 +1,61 @@
+#include "settings_profiles.hpp"
+
+#include <algorithm>
+
+namespace robikzinputtest {
+
+const std::string SettingsProfiles::DEFAULT_PROFILE = "default";
+
+bool SettingsProfiles::is_valid_name(std::string_view name) {
+	return !name.empty()
+		&& name.size() <= MAX_NAME_LENGTH
+		&& std::all_of(name.begin(), name.end(), [](char c) {
+			return (c >= 'a' && c <= 'z')
+				|| (c >= 'A' && c <= 'Z')
+				|| (c >= '0' && c <= '9')
+				|| c == '-'
+				|| c == '_';
+		});
+}
+
+SettingsProfiles::SettingsProfiles()
+	: m_active(DEFAULT_PROFILE) {
+	m_profiles[DEFAULT_PROFILE] = Settings();
+}
+
+std::vector<std::string> SettingsProfiles::names() const {
+	std::vector<std::string> names;
+	names.reserve(m_profiles.size());
+	for (const auto &profile : m_profiles) {
+		names.push_back(profile.first);
+	}
+	return names;
+}
+
+const std::string &SettingsProfiles::next() const {
+	auto it = m_profiles.upper_bound(m_active);
+	if (it == m_profiles.end()) {
+		it = m_profiles.begin();
+	}
+	return it->first;
+}
+
+void SettingsProfiles::set(const std::string &name, const Settings &settings) {
+	m_profiles[name] = settings;
+}
+
+bool SettingsProfiles::switch_to(const std::string &name, Settings &running) {
+	auto it = m_profiles.find(name);
+	if (it == m_profiles.end()) {
+		return false;
+	}
+	if (name == m_active) {
+		return true;
+	}
+	m_profiles[m_active] = running;
+	running = it->second;
+	m_active = name;
+	return true;
+}
+
+} // namespace robikzinputtest
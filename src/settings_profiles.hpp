@@ -0,0 +1,50 @@
+#pragma once
+
+#include "settings.hpp"
+
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace robikzinputtest {
+
+/**
+ * Named sets of settings held in memory, one of them active.
+ *
+ * The active profile's settings live outside, as the settings the
+ * program runs with; its copy here is only brought up to date when
+ * another profile is switched to.
+ */
+class SettingsProfiles {
+public:
+	static const std::string DEFAULT_PROFILE;
+	static constexpr size_t MAX_NAME_LENGTH = 64;
+
+	/// Letters, digits, '-' and '_'; the name goes into a file name.
+	static bool is_valid_name(std::string_view name);
+
+	SettingsProfiles();
+
+	const std::string &active() const { return m_active; }
+	bool has(const std::string &name) const { return m_profiles.count(name) != 0; }
+	/// All profile names in order, the default one included.
+	std::vector<std::string> names() const;
+	/// The profile after the active one, wrapping around.
+	const std::string &next() const;
+
+	/// Add or replace a profile; the active one is replaced by switching.
+	void set(const std::string &name, const Settings &settings);
+	/**
+	 * Make the named profile active: store the running settings as the
+	 * active profile's and replace them with the named one's.
+	 * Returns false if there's no such profile.
+	 */
+	bool switch_to(const std::string &name, Settings &running);
+
+private:
+	std::map<std::string, Settings> m_profiles;
+	std::string m_active;
+};
+
+} // namespace robikzinputtest
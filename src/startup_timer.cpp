@@ -0,0 +1,57 @@
+#include "startup_timer.hpp"
+
+#include <iomanip>
+
+namespace robikzinputtest {
+
+static double ns_to_ms(Uint64 ns) {
+	return static_cast<double>(ns) / 1e6;
+}
+
+StartupTimer::StartupTimer()
+	: m_begin_ns(SDL_GetTicksNS()), m_last_mark_ns(m_begin_ns) {
+}
+
+void StartupTimer::mark(const char *stage) {
+	const Uint64 now_ns = SDL_GetTicksNS();
+	m_stages.push_back({ stage, { m_last_mark_ns, now_ns }, false });
+	m_last_mark_ns = now_ns;
+}
+
+void StartupTimer::add_parallel(const char *stage, const StartupSpan &span) {
+	m_stages.push_back({ stage, span, true });
+}
+
+bool StartupTimer::first_frame_presented(Uint64 present_ns) {
+	if (has_first_frame()) {
+		return false;
+	}
+	// The mark of the first frame itself.
+	m_stages.push_back({ "first frame", { m_last_mark_ns, present_ns }, false });
+	m_first_frame_ns = present_ns;
+	return true;
+}
+
+Uint64 StartupTimer::time_to_first_frame_ns() const {
+	return has_first_frame() ? m_first_frame_ns - m_begin_ns : 0;
+}
+
+void StartupTimer::write_report(std::ostream &out) const {
+	const auto flags = out.flags();
+	const auto precision = out.precision();
+	out << std::fixed << std::setprecision(2);
+	for (const Stage &stage : m_stages) {
+		out << "Startup: " << stage.name
+			<< " at " << ns_to_ms(stage.span.begin_ns - m_begin_ns) << " ms"
+			<< " took " << ns_to_ms(stage.span.duration_ns()) << " ms"
+			<< (stage.parallel ? " (in parallel)" : "")
+			<< std::endl;
+	}
+	if (has_first_frame()) {
+		out << "Startup: time to first frame " << ns_to_ms(time_to_first_frame_ns()) << " ms" << std::endl;
+	}
+	out.flags(flags);
+	out.precision(precision);
+}
+
+} // namespace robikzinputtest
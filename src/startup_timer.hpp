@@ -0,0 +1,59 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+
+#include <ostream>
+#include <vector>
+
+namespace robikzinputtest {
+
+/**
+ * When a piece of the startup ran, on the SDL_GetTicksNS() clock.
+ */
+struct StartupSpan {
+	Uint64 begin_ns = 0;
+	Uint64 end_ns = 0;
+
+	Uint64 duration_ns() const { return end_ns - begin_ns; }
+};
+
+/**
+ * Times the stages of the application startup, up to the first
+ * presented frame.
+ *
+ * The main thread stages follow one another: each mark() ends the
+ * stage that ran since the previous mark. Work done on another thread
+ * is timed where it runs and added with add_parallel().
+ */
+class StartupTimer {
+public:
+	struct Stage {
+		const char *name;
+		StartupSpan span;
+		bool parallel;
+	};
+
+	/// Startup begins now.
+	StartupTimer();
+
+	/// End the main thread stage that ran since the previous mark.
+	void mark(const char *stage);
+	void add_parallel(const char *stage, const StartupSpan &span);
+	/// Returns true for the first frame only.
+	bool first_frame_presented(Uint64 present_ns);
+
+	bool has_first_frame() const { return m_first_frame_ns != 0; }
+	Uint64 time_to_first_frame_ns() const;
+	const std::vector<Stage> &stages() const { return m_stages; }
+
+	/// Write each stage and the time to the first frame, one per line.
+	void write_report(std::ostream &out) const;
+
+private:
+	Uint64 m_begin_ns;
+	Uint64 m_last_mark_ns;
+	Uint64 m_first_frame_ns = 0;
+	std::vector<Stage> m_stages;
+};
+
+} // namespace robikzinputtest
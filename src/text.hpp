@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <string>
+#include <string_view>
 
 namespace robikzinputtest::text {
 inline std::string ltrim(std::string s) {
@@ -38,4 +39,36 @@ inline std::string tolower(std::string s) {
 	return s;
 }
 
+constexpr bool is_ascii_space(char c) {
+	return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
+}
+
+/// Trim the whitespace without copying; the view points into the same text.
+constexpr std::string_view trim_view(std::string_view s) {
+	while (!s.empty() && is_ascii_space(s.front())) {
+		s.remove_prefix(1);
+	}
+	while (!s.empty() && is_ascii_space(s.back())) {
+		s.remove_suffix(1);
+	}
+	return s;
+}
+
+constexpr char ascii_tolower(char c) {
+	return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+/// Compare ASCII text case-insensitively, without copying it.
+constexpr bool equals_ignore_case(std::string_view a, std::string_view b) {
+	if (a.size() != b.size()) {
+		return false;
+	}
+	for (size_t i = 0; i < a.size(); ++i) {
+		if (ascii_tolower(a[i]) != ascii_tolower(b[i])) {
+			return false;
+		}
+	}
+	return true;
+}
+
 } // namespace robikzinputtest:text
@@ -1,43 +1,248 @@
 #include "variant.hpp"
 
+#include "text.hpp"
 #include "video.hpp"
 #include "video_settings.hpp"
 
-#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <limits>
 
 namespace robikzinputtest {
 
-bool Variant::as_bool() const {
-	std::string lowervalue(this->m_value.size(), '\0');
-	std::transform(
-		this->m_value.begin(), this->m_value.end(), lowervalue.begin(),
-		[](unsigned char c) { return std::tolower(c); }
-	);
-	return lowervalue == "true"
-		|| lowervalue == "yes"
-		|| lowervalue == "on"
-		|| as_int64() != 0
-		;
+/*
+  Text conversions
+*/
+
+/// from_chars() takes no plus sign, which strtod() and friends did.
+static std::string_view skip_plus_sign(std::string_view text) {
+	if (!text.empty() && text.front() == '+') {
+		text.remove_prefix(1);
+	}
+	return text;
+}
+
+template <typename T>
+static T parse_number(std::string_view text) {
+	text = skip_plus_sign(text);
+	T value {};
+	if (std::from_chars(text.data(), text.data() + text.size(), value).ec != std::errc()) {
+		return T {};
+	}
+	return value;
+}
+
+template <typename T>
+static void append_number(std::string &out, T value) {
+	char buffer[Variant::NUMBER_TEXT_MAX];
+	const auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+	out.append(buffer, result.ptr);
+}
+
+static void append_color(std::string &out, const Color &color) {
+	static constexpr char DIGITS[] = "0123456789ABCDEF";
+	for (int i = 0; i < 4; ++i) {
+		const uint8_t u8 = punit_to_u8<uint8_t>(color[i]);
+		out.push_back(DIGITS[u8 >> 4]);
+		out.push_back(DIGITS[u8 & 0xf]);
+	}
+}
+
+/// Truncate like strtoll() did with a fraction, without overflowing.
+static int64_t truncate_to_int64(double value) {
+	if (std::isnan(value)) {
+		return 0;
+	}
+	if (value <= static_cast<double>(std::numeric_limits<int64_t>::min())) {
+		return std::numeric_limits<int64_t>::min();
+	}
+	if (value >= static_cast<double>(std::numeric_limits<int64_t>::max())) {
+		return std::numeric_limits<int64_t>::max();
+	}
+	return static_cast<int64_t>(value);
+}
+
+/*
+  Variant
+*/
+
+std::string Variant::as_string() const {
+	if (const std::string *s = std::get_if<std::string>(&m_value)) {
+		return *s;
+	}
+	std::string out;
+	append_to(out);
+	return out;
 }
 
-int32_t Variant::as_int32() const {
-	return std::strtol(this->m_value.c_str(), nullptr, 10);
+void Variant::append_to(std::string &out) const {
+	switch (type()) {
+	case Type::NONE:
+		break;
+	case Type::STRING:
+		out += std::get<std::string>(m_value);
+		break;
+	case Type::BOOL:
+		out += std::get<bool>(m_value) ? "true" : "false";
+		break;
+	case Type::INT:
+		append_number(out, std::get<int64_t>(m_value));
+		break;
+	case Type::UINT:
+		append_number(out, std::get<uint64_t>(m_value));
+		break;
+	case Type::FLOAT:
+		append_number(out, std::get<float>(m_value));
+		break;
+	case Type::DOUBLE:
+		append_number(out, std::get<double>(m_value));
+		break;
+	case Type::COLOR:
+		append_color(out, std::get<Color>(m_value));
+		break;
+	}
 }
 
-uint32_t Variant::as_uint32() const {
-	return std::strtoul(this->m_value.c_str(), nullptr, 10);
+size_t Variant::text_size_max() const {
+	switch (type()) {
+	case Type::NONE:
+		return 0;
+	case Type::STRING:
+		return std::get<std::string>(m_value).size();
+	case Type::BOOL:
+		return 5;
+	case Type::COLOR:
+		// RRGGBBAA
+		return 8;
+	default:
+		return NUMBER_TEXT_MAX;
+	}
+}
+
+bool Variant::as_bool() const {
+	switch (type()) {
+	case Type::NONE:
+		return false;
+	case Type::STRING:
+		return parse_bool(std::get<std::string>(m_value));
+	case Type::BOOL:
+		return std::get<bool>(m_value);
+	case Type::FLOAT:
+	case Type::DOUBLE:
+		return as_double() != 0.0;
+	default:
+		return as_int64() != 0;
+	}
+}
+
+Color Variant::as_color() const {
+	switch (type()) {
+	case Type::COLOR:
+		return std::get<Color>(m_value);
+	case Type::STRING:
+		return Color::from_hex(std::get<std::string>(m_value));
+	default:
+		return {};
+	}
 }
 
 int64_t Variant::as_int64() const {
-	return std::strtoll(this->m_value.c_str(), nullptr, 10);
+	switch (type()) {
+	case Type::NONE:
+		return 0;
+	case Type::STRING:
+		return parse_int64(std::get<std::string>(m_value));
+	case Type::BOOL:
+		return std::get<bool>(m_value) ? 1 : 0;
+	case Type::INT:
+		return std::get<int64_t>(m_value);
+	case Type::UINT:
+		return static_cast<int64_t>(std::get<uint64_t>(m_value));
+	case Type::FLOAT:
+	case Type::DOUBLE:
+		return truncate_to_int64(as_double());
+	case Type::COLOR:
+		return 0;
+	}
+	return 0;
 }
 
 float Variant::as_float() const {
-	return std::strtof(this->m_value.c_str(), nullptr);
+	switch (type()) {
+	case Type::STRING:
+		return parse_float(std::get<std::string>(m_value));
+	case Type::FLOAT:
+		return std::get<float>(m_value);
+	default:
+		return static_cast<float>(as_double());
+	}
 }
 
 double Variant::as_double() const {
-	return std::strtod(this->m_value.c_str(), nullptr);
+	switch (type()) {
+	case Type::STRING:
+		return parse_double(std::get<std::string>(m_value));
+	case Type::FLOAT:
+		return std::get<float>(m_value);
+	case Type::DOUBLE:
+		return std::get<double>(m_value);
+	case Type::UINT:
+		return static_cast<double>(std::get<uint64_t>(m_value));
+	default:
+		return static_cast<double>(as_int64());
+	}
+}
+
+bool Variant::parse_bool(std::string_view text) {
+	return text::equals_ignore_case(text, "true")
+		|| text::equals_ignore_case(text, "yes")
+		|| text::equals_ignore_case(text, "on")
+		|| parse_int64(text) != 0
+		;
+}
+
+int64_t Variant::parse_int64(std::string_view text) {
+	return parse_number<int64_t>(text);
+}
+
+float Variant::parse_float(std::string_view text) {
+	// Parsed as a float, so that its shortest text comes back exact.
+	return parse_number<float>(text);
+}
+
+double Variant::parse_double(std::string_view text) {
+	return parse_number<double>(text);
+}
+
+bool Variant::operator==(const Variant &other) const {
+	if (type() != other.type()) {
+		if (!valid() || !other.valid()) {
+			return false;
+		}
+		return as_string() == other.as_string();
+	}
+	switch (type()) {
+	case Type::NONE:
+		return true;
+	case Type::STRING:
+		return std::get<std::string>(m_value) == std::get<std::string>(other.m_value);
+	case Type::BOOL:
+		return std::get<bool>(m_value) == std::get<bool>(other.m_value);
+	case Type::INT:
+		return std::get<int64_t>(m_value) == std::get<int64_t>(other.m_value);
+	case Type::UINT:
+		return std::get<uint64_t>(m_value) == std::get<uint64_t>(other.m_value);
+	case Type::FLOAT:
+		return std::get<float>(m_value) == std::get<float>(other.m_value);
+	case Type::DOUBLE:
+		return std::get<double>(m_value) == std::get<double>(other.m_value);
+	case Type::COLOR: {
+		const Color &a = std::get<Color>(m_value);
+		const Color &b = std::get<Color>(other.m_value);
+		return a.r == b.r && a.g == b.g && a.b == b.b && a.a == b.a;
+	}
+	}
+	return false;
 }
 
 /*
@@ -52,7 +257,10 @@ Variant::operator DisplayIdMemo() const {
 }
 
 DisplayIdMemo Variant::as_display_id_memo() const {
-	return decode_display_id_memo(this->m_value);
+	if (const std::string *s = std::get_if<std::string>(&m_value)) {
+		return decode_display_id_memo(*s);
+	}
+	return decode_display_id_memo(as_string());
 }
 
 } // namespace robikzinputtest
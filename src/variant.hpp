@@ -3,20 +3,51 @@
 #include "color.hpp"
 #include "video_defs.hpp"
 
+#include <cstdint>
 #include <string>
+#include <string_view>
+#include <variant>
 
 namespace robikzinputtest {
 
+/**
+ * A value of one of the property types, kept in its native form.
+ *
+ * The conversions between the types, and from and to the text form,
+ * go through std::from_chars() and std::to_chars(): they are exact,
+ * don't depend on the locale and don't allocate. The text form is
+ * only made when the value is written out.
+ */
 class Variant {
 public:
-	Variant() : m_valid(false) {}
-	Variant(std::string s) : m_value(s) {}
-	Variant(bool b) : m_value(b ? "true" : "false") {}
-	Variant(Color color) : m_value(color.to_rgba_hex()) {}
-	Variant(int32_t i) : m_value(std::to_string(i)) {}
-	Variant(uint32_t i) : m_value(std::to_string(i)) {}
-	Variant(int64_t i) : m_value(std::to_string(i)) {}
-	Variant(double d) : m_value(std::to_string(d)) {}
+	/// The index of each type in the value.
+	enum class Type {
+		NONE,
+		STRING,
+		BOOL,
+		INT,
+		UINT,
+		FLOAT,
+		DOUBLE,
+		COLOR,
+	};
+
+	/// Room for the longest number std::to_chars() writes, a double.
+	static constexpr size_t NUMBER_TEXT_MAX = 32;
+
+	Variant() {}
+	Variant(std::string s) : m_value(std::move(s)) {}
+	Variant(std::string_view s) : m_value(std::string(s)) {}
+	Variant(const char *s) : m_value(std::string(s)) {}
+	Variant(bool b) : m_value(b) {}
+	Variant(Color color) : m_value(color) {}
+	Variant(int32_t i) : m_value(static_cast<int64_t>(i)) {}
+	Variant(uint32_t i) : m_value(static_cast<uint64_t>(i)) {}
+	Variant(int64_t i) : m_value(i) {}
+	Variant(uint64_t i) : m_value(i) {}
+	Variant(float f) : m_value(f) {}
+	Variant(double d) : m_value(d) {}
+	/// Kept in its text form; it has a name in it anyway.
 	Variant(const DisplayIdMemo &display_id_memo);
 
 	operator std::string() const { return as_string(); }
@@ -29,33 +60,51 @@ public:
 	operator double() const { return as_double(); }
 	operator DisplayIdMemo() const;
 
-	const std::string &as_string() const { return m_value; }
+	/// The text form, as written to files.
+	std::string as_string() const;
+	/// Append the text form to the string.
+	void append_to(std::string &out) const;
+	/// Longest the text form can be, to size a buffer up front.
+	size_t text_size_max() const;
 	bool as_bool() const;
-	Color as_color() const { return Color::from_hex(m_value); }
-	int32_t as_int32() const;
-	uint32_t as_uint32() const;
+	Color as_color() const;
+	int32_t as_int32() const { return static_cast<int32_t>(as_int64()); }
+	uint32_t as_uint32() const { return static_cast<uint32_t>(as_int64()); }
 	int64_t as_int64() const;
 	float as_float() const;
 	double as_double() const;
 	DisplayIdMemo as_display_id_memo() const;
 
-	bool valid() const { return m_valid; }
+	/**
+	 * Convert the text form straight from a view, the way a STRING
+	 * value is, without making a Variant of it first.
+	 */
+	static bool parse_bool(std::string_view text);
+	static int64_t parse_int64(std::string_view text);
+	static float parse_float(std::string_view text);
+	static double parse_double(std::string_view text);
 
-	bool operator==(const Variant &other) const {
-		if (!m_valid && !other.m_valid)
-			return true;
-		if (m_valid != other.m_valid)
-			return false;
-		return m_value == other.m_value;
-	}
+	Type type() const { return static_cast<Type>(m_value.index()); }
+	bool valid() const { return type() != Type::NONE; }
+
+	/// Values of the same type compare natively, others by their text.
+	bool operator==(const Variant &other) const;
 
 	bool operator!=(const Variant &other) const {
 		return !(*this == other);
 	}
 
 private:
-	bool m_valid = true;
-	std::string m_value;
+	std::variant<
+		std::monostate,
+		std::string,
+		bool,
+		int64_t,
+		uint64_t,
+		float,
+		double,
+		Color
+	> m_value;
 };
 
 } // namespace robikzinputtest
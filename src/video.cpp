@@ -182,7 +182,7 @@ VideoModeSettings get_best_fullscreen_settings_for_window_and_display(
 	return pick_best_display_mode(available_modes);
 }
 
-std::string get_display_mode_label(DisplayMode display_mode) {
+const char *get_display_mode_label(DisplayMode display_mode) {
 	switch (display_mode) {
 	case DisplayMode::WINDOWED:
 		return "Windowed";
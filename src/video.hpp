@@ -132,7 +132,7 @@ VideoModeSettings get_best_fullscreen_settings_for_window_and_display(
 	SDL_DisplayID display_id
 );
 
-std::string get_display_mode_label(DisplayMode display_mode);
+const char *get_display_mode_label(DisplayMode display_mode);
 
 inline SDL_DisplayID get_window_display(SDL_Window *window) {
 	return SDL_GetDisplayForWindow(window);
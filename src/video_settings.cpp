@@ -3,13 +3,15 @@
 #include "settings.hpp"
 #include "video.hpp"
 
+#include <charconv>
+
 namespace robikzinputtest {
 
 std::string encode_display_id_memo(const DisplayIdMemo &display_id_memo) {
 	return std::to_string(display_id_memo.id) + "|" + display_id_memo.name;
 }
 
-DisplayIdMemo decode_display_id_memo(const std::string &encoded_display_id_memo) {
+DisplayIdMemo decode_display_id_memo(std::string_view encoded_display_id_memo) {
 	DisplayIdMemo decoded_display_id_memo = {
 		// SDL functions such as SDL_GetPrimaryDisplay() return 0 when
 		// display cannot be established.
@@ -17,15 +19,17 @@ DisplayIdMemo decode_display_id_memo(const std::string &encoded_display_id_memo)
 		"Unknown Display",
 	};
 	const size_t separator_pos = encoded_display_id_memo.find('|');
-	if (separator_pos == std::string::npos) {
+	if (separator_pos == std::string_view::npos) {
+		return decoded_display_id_memo;
+	}
+	const char *id_end = encoded_display_id_memo.data() + separator_pos;
+	SDL_DisplayID display_id = 0;
+	const auto parsed = std::from_chars(encoded_display_id_memo.data(), id_end, display_id);
+	if (parsed.ec != std::errc() || parsed.ptr != id_end) {
 		return decoded_display_id_memo;
 	}
-	const SDL_DisplayID display_id = static_cast<SDL_DisplayID>(
-		std::stoll(encoded_display_id_memo.substr(0, separator_pos))
-	);
-	const std::string display_name = encoded_display_id_memo.substr(separator_pos + 1);
 	decoded_display_id_memo.id = display_id;
-	decoded_display_id_memo.name = display_name;
+	decoded_display_id_memo.name = std::string(encoded_display_id_memo.substr(separator_pos + 1));
 	return decoded_display_id_memo;
 }
 
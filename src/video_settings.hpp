@@ -4,6 +4,7 @@
 
 #include <SDL3/SDL.h>
 #include <string>
+#include <string_view>
 
 namespace robikzinputtest {
 
@@ -11,7 +12,8 @@ class Settings;
 struct VideoModeSettings;
 
 std::string encode_display_id_memo(const DisplayIdMemo &display_id_memo);
-DisplayIdMemo decode_display_id_memo(const std::string &encoded_display_id_memo);
+/// A malformed memo decodes to the unknown display.
+DisplayIdMemo decode_display_id_memo(std::string_view encoded_display_id_memo);
 
 void save_window_video_settings(Settings &settings, SDL_Window *window);
 void load_window_video_settings(const Settings &settings, SDL_Window *window);